@@ -0,0 +1,353 @@
+#include "BatchRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "CPMCalculator.h"
+#include "DataLoader.h"
+#include "DataLoader_pert.h"
+#include "NormalDistribution.h"
+#include "PERTCalculator.h"
+#include "ProjectGraph.h"
+#include "ThreadPool.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Records comparisons against the reference solution and keeps the first mismatch.
+class Checker
+{
+public:
+    Checker(BatchItem& item, const BatchOptions& options) : item_(item), options_(options) {}
+
+    void exact(const std::string& what, double actual, double expected)
+    {
+        compare(what, actual, expected, 0.0);
+    }
+
+    void close(const std::string& what, double actual, double expected)
+    {
+        compare(what, actual, expected,
+                std::max(options_.absoluteTolerance, options_.relativeTolerance * std::abs(expected)));
+    }
+
+    void require(bool condition, const std::string& message)
+    {
+        ++item_.checkedValues;
+        if (!condition && item_.message.empty())
+        {
+            item_.message = message;
+        }
+    }
+
+    void finish()
+    {
+        if (item_.checkedValues == 0)
+        {
+            item_.status = BatchStatus::Unchecked;
+        }
+        else
+        {
+            item_.status = item_.message.empty() ? BatchStatus::Passed : BatchStatus::Failed;
+        }
+    }
+
+private:
+    void compare(const std::string& what, double actual, double expected, double tolerance)
+    {
+        ++item_.checkedValues;
+        if (std::abs(actual - expected) > tolerance && item_.message.empty())
+        {
+            std::ostringstream message;
+            message << what << ": got " << actual << ", expected " << expected;
+            item_.message = message.str();
+        }
+    }
+
+    BatchItem& item_;
+    const BatchOptions& options_;
+};
+
+// True when `path` (task ids) is a chain of dependencies with zero slack from
+// time 0 to `duration`; `reason` says why not otherwise. Files may show
+// any one of several equally critical paths, so the reference path is
+// validated against the computed schedule instead of compared with
+// CPMResult::criticalPath / PERTResult::criticalPath.
+template <typename T>
+bool isCriticalChain(const ProjectGraph& graph,
+                     const ProjectSchedule<T>& schedule,
+                     const std::vector<int>& path,
+                     T duration,
+                     T tolerance,
+                     std::string& reason)
+{
+    if (path.empty())
+    {
+        reason = "critical path is empty";
+        return false;
+    }
+
+    int previous = -1;
+    for (int id : path)
+    {
+        const int index = graph.indexOf(id);
+        if (index < 0)
+        {
+            reason = "critical path task " + std::to_string(id) + " does not exist";
+            return false;
+        }
+        if (std::abs(schedule.LS[index] - schedule.ES[index]) > tolerance)
+        {
+            reason = "critical path task " + std::to_string(id) + " has slack";
+            return false;
+        }
+        const bool follows = previous < 0
+                                 ? std::abs(schedule.ES[index]) <= tolerance
+                                 : std::abs(schedule.ES[index] - schedule.EF[previous]) <= tolerance &&
+                                       std::find(graph.successors(previous).begin(), graph.successors(previous).end(),
+                                                 index) != graph.successors(previous).end();
+        if (!follows)
+        {
+            reason = "critical path breaks at task " + std::to_string(id);
+            return false;
+        }
+        previous = index;
+    }
+    if (std::abs(schedule.EF[previous] - duration) > tolerance)
+    {
+        reason = "critical path ends before the project";
+        return false;
+    }
+    return true;
+}
+
+void analyzeCpm(BatchItem& item, const ExpectedResults& expected, const BatchOptions& options)
+{
+    LoadOptions loadOptions;
+    loadOptions.threadCount = 1;
+
+    const ProjectData data = DataLoader::read_data(item.file, loadOptions);
+    if (!data.success)
+    {
+        item.message = "could not be read";
+        return;
+    }
+    const ProjectGraph graph = ProjectGraph::compile(data.tasks);
+    item.taskCount = graph.size();
+    item.edgeCount = graph.edgeCount();
+    if (static_cast<int>(graph.topologicalOrder().size()) != graph.size())
+    {
+        item.message = "dependency cycle";
+        return;
+    }
+
+    const auto start = Clock::now();
+    ProjectSchedule<int> schedule;
+    const CPMResult result = CPMCalculator::analyze(graph, schedule);
+    item.analysisMilliseconds = millisecondsSince(start);
+    item.duration = result.totalDuration;
+
+    Checker check(item, options);
+    if (expected.hasProcessTime)
+    {
+        check.exact("process time", result.totalDuration, expected.processTime);
+    }
+    for (std::size_t i = 0; i < expected.schedule.size(); ++i)
+    {
+        const int id = static_cast<int>(i) + 1;
+        const int index = graph.indexOf(id);
+        if (index < 0)
+        {
+            check.require(false, "task " + std::to_string(id) + " does not exist");
+            continue;
+        }
+        const std::string task = "task " + std::to_string(id);
+        check.exact(task + " ES", schedule.ES[index], expected.schedule[i].earlyStart);
+        check.exact(task + " EF", schedule.EF[index], expected.schedule[i].earlyFinish);
+        check.exact(task + " LS", schedule.LS[index], expected.schedule[i].lateStart);
+        check.exact(task + " LF", schedule.LF[index], expected.schedule[i].lateFinish);
+    }
+    if (!expected.criticalPath.empty())
+    {
+        std::vector<int> path;
+        for (const ExpectedCriticalTask& task : expected.criticalPath)
+        {
+            path.push_back(task.id);
+            const int index = graph.indexOf(task.id);
+            if (index >= 0)
+            {
+                const std::string label = "critical path task " + std::to_string(task.id);
+                check.exact(label + " ES", schedule.ES[index], task.earlyStart);
+                check.exact(label + " EF", schedule.EF[index], task.earlyFinish);
+            }
+        }
+        std::string reason;
+        check.require(isCriticalChain(graph, schedule, path, result.totalDuration, 0, reason), reason);
+    }
+    check.finish();
+}
+
+void analyzePert(BatchItem& item, const ExpectedResults& expected, const BatchOptions& options)
+{
+    LoadOptions loadOptions;
+    loadOptions.threadCount = 1;
+
+    const ProjectDataPert data = DataLoader_pert::read_data(item.file, loadOptions);
+    if (!data.success)
+    {
+        item.message = "could not be read";
+        return;
+    }
+    const ProjectGraph graph = ProjectGraph::compile(data.tasks);
+    item.taskCount = graph.size();
+    item.edgeCount = graph.edgeCount();
+    if (static_cast<int>(graph.topologicalOrder().size()) != graph.size())
+    {
+        item.message = "dependency cycle";
+        return;
+    }
+
+    const auto start = Clock::now();
+    ProjectSchedule<double> schedule;
+    const PERTResult result = PERTCalculator::analyze(graph, schedule);
+    item.analysisMilliseconds = millisecondsSince(start);
+    item.duration = result.expectedDuration;
+
+    Checker check(item, options);
+    if (expected.hasPertSolution)
+    {
+        // The deviation belongs to the path the file chose, which may be
+        // another of several critical paths than PERTResult's.
+        double standardDeviation = result.standardDeviation;
+        std::string reason;
+        const double tolerance = 1e-9 * std::max(1.0, result.expectedDuration);
+        const bool critical =
+            isCriticalChain(graph, schedule, expected.pertCriticalPath, result.expectedDuration, tolerance, reason);
+        check.require(critical, reason);
+        if (critical)
+        {
+            double variance = 0.0;
+            for (int id : expected.pertCriticalPath)
+            {
+                variance += graph.variances()[graph.indexOf(id)];
+            }
+            standardDeviation = std::sqrt(variance);
+        }
+
+        check.close("expected duration", result.expectedDuration, expected.expectedDuration);
+        check.close("standard deviation", standardDeviation, expected.standardDeviation);
+
+        double onTimeProbability = data.target_time >= result.expectedDuration ? 1.0 : 0.0;
+        if (standardDeviation > 0.0)
+        {
+            onTimeProbability = standardNormalCDF((data.target_time - result.expectedDuration) / standardDeviation);
+        }
+        check.close("on-time probability", onTimeProbability, expected.onTimeProbability);
+
+        const double targetProbabilityTime =
+            result.expectedDuration + standardDeviation * standardNormalQuantile(data.target_probability);
+        check.close("time for target probability", targetProbabilityTime, expected.targetProbabilityTime);
+    }
+    check.finish();
+}
+
+void analyzeFile(BatchItem& item, const BatchOptions& options)
+{
+    const auto start = Clock::now();
+    const ExpectedResults expected = ExpectedResultsLoader::read_data(item.file);
+    item.format = expected.format;
+    if (!expected.success)
+    {
+        item.message = std::filesystem::is_regular_file(item.file) ? "unknown format" : "could not be read";
+        return;
+    }
+
+    if (expected.format == ProjectFormat::Cpm)
+    {
+        analyzeCpm(item, expected, options);
+    }
+    else
+    {
+        analyzePert(item, expected, options);
+    }
+    item.loadMilliseconds = millisecondsSince(start) - item.analysisMilliseconds;
+}
+}
+
+int BatchSummary::count(BatchStatus status) const
+{
+    return static_cast<int>(std::count_if(items.begin(), items.end(),
+                                          [status](const BatchItem& item) { return item.status == status; }));
+}
+
+std::vector<std::string> BatchRunner::collectFiles(const std::string& path)
+{
+    namespace fs = std::filesystem;
+
+    std::vector<std::string> files;
+    std::error_code error;
+    if (fs::is_directory(path, error))
+    {
+        for (const fs::directory_entry& entry : fs::directory_iterator(path, error))
+        {
+            if (entry.is_regular_file(error))
+            {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    std::ifstream list(path);
+    const fs::path base = fs::path(path).parent_path();
+    std::string line;
+    while (std::getline(list, line))
+    {
+        const std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+        {
+            continue;
+        }
+        const std::size_t last = line.find_last_not_of(" \t\r");
+        const fs::path file = line.substr(first, last - first + 1);
+        files.push_back(file.is_absolute() ? file.string() : (base / file).string());
+    }
+    return files;
+}
+
+BatchSummary BatchRunner::run(const std::vector<std::string>& files, const BatchOptions& options)
+{
+    const auto start = Clock::now();
+
+    BatchSummary summary;
+    summary.items.resize(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        summary.items[i].file = files[i];
+    }
+
+    ThreadPool pool(options.threadCount);
+    summary.threadCount = pool.threadCount();
+    pool.parallelFor(static_cast<int>(files.size()), 1,
+                     [&](int begin, int end)
+                     {
+                         for (int i = begin; i < end; ++i)
+                         {
+                             analyzeFile(summary.items[i], options);
+                         }
+                     });
+
+    summary.wallMilliseconds = millisecondsSince(start);
+    return summary;
+}
@@ -0,0 +1,66 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <string>
+#include <vector>
+
+#include "ExpectedResults.h"
+
+struct BatchOptions
+{
+    int threadCount = 0; // 0 = one thread per hardware core
+
+    // PERT values are rounded in the files, so they match when within the
+    // larger of the two tolerances; CPM values are compared exactly.
+    double absoluteTolerance = 0.01;
+    double relativeTolerance = 0.01;
+};
+
+enum class BatchStatus
+{
+    Passed,    // every reference value in the file matched
+    Failed,    // some reference value differs (see BatchItem::message)
+    Unchecked, // analysed, but the file carries no reference solution
+    Error      // unreadable, unknown format or cyclic dependencies
+};
+
+struct BatchItem
+{
+    std::string file;
+    ProjectFormat format = ProjectFormat::Unknown;
+    BatchStatus status = BatchStatus::Error;
+    std::string message; // first mismatch or the error
+    int taskCount = 0;
+    int edgeCount = 0;
+    double duration = 0.0; // CPM project duration or PERT expected duration
+    int checkedValues = 0; // reference values compared
+    double loadMilliseconds = 0.0;     // format detection, loading and compiling
+    double analysisMilliseconds = 0.0;
+};
+
+struct BatchSummary
+{
+    std::vector<BatchItem> items; // in input order
+    int threadCount = 0;
+    double wallMilliseconds = 0.0;
+
+    int count(BatchStatus status) const;
+};
+
+// Analyses a corpus of CPM and PERT text files in one process. Every file is
+// one work item on a ThreadPool: its format is detected, it is loaded (each
+// loader single-threaded, the files themselves are the parallelism),
+// analysed with the graph-based calculators and checked against the
+// reference solution embedded in the file.
+class BatchRunner
+{
+public:
+    // The regular files of a directory sorted by name, or the paths listed in a
+    // file, one per line; relative paths are relative to the list file, empty
+    // lines and lines starting with '#' are skipped.
+    static std::vector<std::string> collectFiles(const std::string& path);
+
+    static BatchSummary run(const std::vector<std::string>& files, const BatchOptions& options);
+};
+
+#endif // BATCH_RUNNER_H
@@ -0,0 +1,59 @@
+#ifndef BENCHMARK_SUPPORT_H
+#define BENCHMARK_SUPPORT_H
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <string>
+
+// Fixtures shared by the stand-alone benchmarks.
+namespace BenchmarkSupport
+{
+// Synthetic CPM text file: `tasks` random durations (1 .. 100) on one line,
+// `dependencies` random forward edges (so the project stays acyclic) on the
+// next, then `trailer`. The same arguments always write the same file.
+inline void writeCpmInput(const std::string& path, int tasks, int dependencies, const char* trailer = "\n")
+{
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> duration(1, 100);
+    std::uniform_int_distribution<int> task(1, tasks);
+
+    std::ofstream file(path, std::ios::binary);
+    file << tasks << ' ' << dependencies << '\n';
+    for (int i = 0; i < tasks; ++i)
+    {
+        file << duration(rng) << ' ';
+    }
+    file << '\n';
+    for (int i = 0; i < dependencies; ++i)
+    {
+        int pred = task(rng);
+        int succ = task(rng);
+        if (pred == succ)
+        {
+            succ = pred == tasks ? 1 : pred + 1;
+        }
+        file << std::min(pred, succ) << ' ' << std::max(pred, succ) << "  ";
+    }
+    file << trailer;
+}
+
+// Best wall-clock time of `repetitions` runs, in milliseconds.
+template <typename Run>
+double bestMilliseconds(int repetitions, const Run& run)
+{
+    double best = 0.0;
+    for (int r = 0; r < repetitions; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const double elapsed =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = r == 0 ? elapsed : std::min(best, elapsed);
+    }
+    return best;
+}
+}
+
+#endif // BENCHMARK_SUPPORT_H
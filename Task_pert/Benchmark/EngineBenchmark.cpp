@@ -0,0 +1,507 @@
+// Regression benchmark of every engine across graph shapes and sizes.
+//
+// Usage: EngineBenchmark [--sizes 1000,10000,100000] [--density 4]
+//                        [--repetitions 15] [--warmup 2] [--samples 10000]
+//                        [--corpus problem_data] [--filter text]
+//
+// Generated shapes (task ids follow the dependencies, i.e. "dataSort" order):
+//   chain    N tasks in a single sequence
+//   fan      one source, N - 2 parallel tasks, one sink (like pert_data_3.txt)
+//   layered  sqrt(N) layers, every task depending on `density` tasks of the
+//            previous layer
+//   random   density * N random forward dependencies
+// plus every file of the corpus directory (format detected per file).
+//
+// Measured per shape: DataLoader::read_data, DataLoader_pert::read_data,
+// CPMCalculator::analyze, CPMCalculator::analyzeBellmanFord (up to
+// kBellmanFordTaskLimit tasks), PathEnumerator::longestPaths (the
+// kPathCount longest paths), PERTCalculator::analyze,
+// PERTCalculator::analyzeClark and PERTCalculator::analyzeSimulation (one
+// thread, fixed seed, `samples` samples capped at kSimulationBudget
+// task-samples).
+// After `warmup` untimed runs every engine runs `repetitions` times.
+//
+// Output is one JSON object per line (engine, shape, tasks, edges, median_ms,
+// p99_ms, min_ms, throughput with its unit, and the operator new calls and
+// bytes of one run), for diffing against a stored baseline. The Clark
+// estimate is also cross-validated against that simulation: one "check" line
+// per correlation setting with the mean, standard deviation and 95th
+// percentile of both, the relative errors of the estimate, whether its
+// percentiles were clipped to the project's bounds, and whether the errors are
+// within kClarkTolerance (mean, 95th percentile) and
+// kClarkStandardDeviationTolerance; a check outside them is also reported on
+// stderr.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CPMCalculator.h"
+#include "DataLoader.h"
+#include "DataLoader_pert.h"
+#include "ExpectedResults.h"
+#include "PERTCalculator.h"
+#include "PathEnumerator.h"
+#include "ProjectGraph.h"
+
+namespace
+{
+std::atomic<std::uint64_t> allocationCount{0};
+std::atomic<std::uint64_t> allocatedBytes{0};
+}
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size != 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+constexpr std::uint32_t kSeed = 2024;
+constexpr double kSimulationBudget = 5e7; // tasks * samples per simulation run
+constexpr int kBellmanFordTaskLimit = 20000; // its late-time pass is quadratic on deep graphs
+constexpr int kPathCount = 1000;
+constexpr int kClarkCorrelationTerms[] = {0, 32}; // independent predecessors, default tracking
+constexpr double kClarkTolerance = 0.1;                  // relative error of the mean and the 95th percentile
+constexpr double kClarkStandardDeviationTolerance = 1.0; // the independent setting underestimates it on layered graphs
+constexpr const char* kCpmFile = "engine_benchmark_input.txt";
+constexpr const char* kPertFile = "engine_benchmark_input_pert.txt";
+
+struct Settings
+{
+    std::vector<int> sizes = {1000, 10000, 100000};
+    int density = 4;
+    int repetitions = 15;
+    int warmup = 2;
+    int samples = 10000;
+    std::string corpus = "problem_data";
+    std::string filter;
+};
+
+// Generated project: (optimistic, most likely, pessimistic) per task, the CPM
+// duration being the most likely time, and "pred succ" pairs.
+struct Project
+{
+    std::string shape;
+    std::vector<int> optimistic;
+    std::vector<int> mostLikely;
+    std::vector<int> pessimistic;
+    std::vector<std::pair<int, int>> edges;
+};
+
+struct Measurement
+{
+    double medianMs = 0.0;
+    double p99Ms = 0.0;
+    double minMs = 0.0;
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+};
+
+Project makeProject(const std::string& shape, int tasks, int density, std::mt19937& rng)
+{
+    Project project;
+    project.shape = shape;
+
+    std::uniform_int_distribution<int> optimisticDist(1, 20);
+    std::uniform_int_distribution<int> spreadDist(0, 20);
+    for (int i = 0; i < tasks; ++i)
+    {
+        const int optimistic = optimisticDist(rng);
+        const int likely = optimistic + spreadDist(rng);
+        project.optimistic.push_back(optimistic);
+        project.mostLikely.push_back(likely);
+        project.pessimistic.push_back(likely + spreadDist(rng));
+    }
+
+    if (shape == "chain")
+    {
+        for (int id = 1; id < tasks; ++id)
+        {
+            project.edges.emplace_back(id, id + 1);
+        }
+    }
+    else if (shape == "fan")
+    {
+        for (int id = 2; id < tasks; ++id)
+        {
+            project.edges.emplace_back(1, id);
+            project.edges.emplace_back(id, tasks);
+        }
+    }
+    else if (shape == "layered")
+    {
+        const int width = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(tasks))));
+        for (int id = width + 1; id <= tasks; ++id)
+        {
+            const int layerStart = (id - 1) / width * width + 1;
+            std::uniform_int_distribution<int> previousLayer(layerStart - width, layerStart - 1);
+            for (int k = 0; k < density; ++k)
+            {
+                project.edges.emplace_back(previousLayer(rng), id);
+            }
+        }
+    }
+    else // random
+    {
+        std::uniform_int_distribution<int> task(1, tasks);
+        for (long long k = 0; k < static_cast<long long>(density) * tasks; ++k)
+        {
+            const int a = task(rng);
+            const int b = task(rng);
+            if (a != b)
+            {
+                project.edges.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+    }
+    return project;
+}
+
+void writeProject(const Project& project, const std::string& cpmPath, const std::string& pertPath)
+{
+    const int tasks = static_cast<int>(project.mostLikely.size());
+    std::ofstream cpm(cpmPath, std::ios::binary);
+    std::ofstream pert(pertPath, std::ios::binary);
+    cpm << tasks << ' ' << project.edges.size() << '\n';
+    pert << tasks << ' ' << project.edges.size() << '\n';
+    for (int i = 0; i < tasks; ++i)
+    {
+        cpm << project.mostLikely[i] << ' ';
+        pert << project.optimistic[i] << ' ' << project.mostLikely[i] << ' ' << project.pessimistic[i] << "   ";
+    }
+    cpm << '\n';
+    pert << '\n';
+
+    std::ostringstream edges;
+    for (const auto& [pred, succ] : project.edges)
+    {
+        edges << pred << ' ' << succ << "  ";
+    }
+    cpm << edges.str() << '\n';
+    pert << edges.str() << '\n' << "100 95" << '\n';
+}
+
+template <typename Run>
+Measurement measure(const Settings& settings, const Run& run)
+{
+    for (int w = 0; w < settings.warmup; ++w)
+    {
+        run();
+    }
+
+    Measurement measurement;
+    std::vector<double> times;
+    times.reserve(settings.repetitions);
+    for (int r = 0; r < settings.repetitions; ++r)
+    {
+        const std::uint64_t allocationsBefore = allocationCount.load();
+        const std::uint64_t bytesBefore = allocatedBytes.load();
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        measurement.allocations = allocationCount.load() - allocationsBefore;
+        measurement.bytes = allocatedBytes.load() - bytesBefore;
+    }
+
+    std::sort(times.begin(), times.end());
+    const std::size_t count = times.size();
+    measurement.minMs = times.front();
+    measurement.medianMs = count % 2 == 1 ? times[count / 2] : (times[count / 2 - 1] + times[count / 2]) / 2.0;
+    measurement.p99Ms = times[static_cast<std::size_t>(std::ceil(0.99 * count)) - 1]; // nearest rank
+    return measurement;
+}
+
+std::string jsonString(const std::string& text)
+{
+    std::string quoted = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + '"';
+}
+
+void report(const char* engine, const std::string& shape, int tasks, int edges, const Measurement& measurement,
+            double work, const char* unit)
+{
+    std::cout << "{\"engine\":" << jsonString(engine)
+              << ",\"shape\":" << jsonString(shape)
+              << ",\"tasks\":" << tasks
+              << ",\"edges\":" << edges
+              << ",\"median_ms\":" << measurement.medianMs
+              << ",\"p99_ms\":" << measurement.p99Ms
+              << ",\"min_ms\":" << measurement.minMs
+              << ",\"throughput\":" << (measurement.medianMs > 0.0 ? work / (measurement.medianMs / 1000.0) : 0.0)
+              << ",\"throughput_unit\":" << jsonString(unit)
+              << ",\"allocations\":" << measurement.allocations
+              << ",\"allocated_bytes\":" << measurement.bytes
+              << "}\n";
+}
+
+bool selected(const Settings& settings, const std::string& engine, const std::string& shape)
+{
+    return settings.filter.empty() || engine.find(settings.filter) != std::string::npos ||
+           shape.find(settings.filter) != std::string::npos;
+}
+
+void benchmarkCpm(const Settings& settings, const std::string& shape, const std::string& path)
+{
+    const ProjectData data = DataLoader::read_data(path);
+    if (!data.success)
+    {
+        return;
+    }
+    const ProjectGraph graph = ProjectGraph::compile(data.tasks);
+    const int tasks = graph.size();
+    const int edges = graph.edgeCount();
+
+    if (selected(settings, "DataLoader::read_data", shape))
+    {
+        report("DataLoader::read_data", shape, tasks, edges,
+               measure(settings, [&] { DataLoader::read_data(path); }), tasks, "tasks/s");
+    }
+
+    ProjectSchedule<int> schedule;
+    if (selected(settings, "CPMCalculator::analyze", shape))
+    {
+        report("CPMCalculator::analyze", shape, tasks, edges,
+               measure(settings, [&] { CPMCalculator::analyze(graph, schedule); }), tasks, "tasks/s");
+    }
+    if (tasks <= kBellmanFordTaskLimit && selected(settings, "CPMCalculator::analyzeBellmanFord", shape))
+    {
+        report("CPMCalculator::analyzeBellmanFord", shape, tasks, edges,
+               measure(settings, [&] { CPMCalculator::analyzeBellmanFord(graph, schedule); }), tasks, "tasks/s");
+    }
+    if (selected(settings, "PathEnumerator::longestPaths", shape))
+    {
+        PathQuery query;
+        query.maxPaths = kPathCount;
+        const int paths = static_cast<int>(PathEnumerator::longestPaths(graph, graph.durations(), query).size());
+        report("PathEnumerator::longestPaths", shape, tasks, edges,
+               measure(settings, [&] { PathEnumerator::longestPaths(graph, graph.durations(), query); }), paths,
+               "paths/s");
+    }
+}
+
+void reportClarkCheck(const std::string& shape, int tasks, int correlationTerms, const ClarkEstimate& estimate,
+                      const PERTSimulation& simulation)
+{
+    auto relativeError = [](double value, double reference)
+    {
+        return reference != 0.0 ? (value - reference) / reference : 0.0;
+    };
+    const double percentile = estimate.getPercentile(95.0);
+    const double referencePercentile = simulation.getPercentile(95.0);
+    const double meanError = relativeError(estimate.meanDuration, simulation.meanDuration);
+    const double standardDeviationError = relativeError(estimate.standardDeviation, simulation.standardDeviation);
+    const double percentileError = relativeError(percentile, referencePercentile);
+    const bool withinTolerance = std::abs(meanError) <= kClarkTolerance &&
+                                 std::abs(percentileError) <= kClarkTolerance &&
+                                 std::abs(standardDeviationError) <= kClarkStandardDeviationTolerance;
+
+    std::cout << "{\"check\":" << jsonString("PERTCalculator::analyzeClark")
+              << ",\"reference\":" << jsonString("PERTCalculator::analyzeSimulation")
+              << ",\"shape\":" << jsonString(shape)
+              << ",\"tasks\":" << tasks
+              << ",\"correlation_terms\":" << correlationTerms
+              << ",\"samples\":" << simulation.simulations
+              << ",\"mean\":" << estimate.meanDuration
+              << ",\"reference_mean\":" << simulation.meanDuration
+              << ",\"mean_error\":" << meanError
+              << ",\"standard_deviation\":" << estimate.standardDeviation
+              << ",\"reference_standard_deviation\":" << simulation.standardDeviation
+              << ",\"standard_deviation_error\":" << standardDeviationError
+              << ",\"p95\":" << percentile
+              << ",\"reference_p95\":" << referencePercentile
+              << ",\"p95_error\":" << percentileError
+              << ",\"clipped_mass\":" << estimate.clippedMass
+              << ",\"clipped\":" << (estimate.clipped ? "true" : "false")
+              << ",\"within_tolerance\":" << (withinTolerance ? "true" : "false")
+              << "}\n";
+    if (!withinTolerance)
+    {
+        std::cerr << "Clark check outside tolerance: " << shape << ", " << tasks << " tasks, " << correlationTerms
+                  << " correlation terms: mean " << estimate.meanDuration << " vs " << simulation.meanDuration
+                  << ", sd " << estimate.standardDeviation << " vs " << simulation.standardDeviation << ", p95 "
+                  << percentile << " vs " << referencePercentile << (estimate.clipped ? " (clipped)" : "") << '\n';
+    }
+}
+
+void benchmarkPert(const Settings& settings, const std::string& shape, const std::string& path)
+{
+    const ProjectDataPert data = DataLoader_pert::read_data(path);
+    if (!data.success)
+    {
+        return;
+    }
+    const ProjectGraph graph = ProjectGraph::compile(data.tasks);
+    const int tasks = graph.size();
+    const int edges = graph.edgeCount();
+
+    if (selected(settings, "DataLoader_pert::read_data", shape))
+    {
+        report("DataLoader_pert::read_data", shape, tasks, edges,
+               measure(settings, [&] { DataLoader_pert::read_data(path); }), tasks, "tasks/s");
+    }
+
+    ProjectSchedule<double> schedule;
+    if (selected(settings, "PERTCalculator::analyze", shape))
+    {
+        report("PERTCalculator::analyze", shape, tasks, edges,
+               measure(settings, [&] { PERTCalculator::analyze(graph, schedule); }), tasks, "tasks/s");
+    }
+
+    SimulationOptions options;
+    options.numSimulations =
+        std::max(1, std::min(settings.samples, static_cast<int>(kSimulationBudget / std::max(1, tasks))));
+    options.threadCount = 1;
+    options.seed = kSeed;
+    options.hasSeed = true;
+
+    if (selected(settings, "PERTCalculator::analyzeClark", shape))
+    {
+        report("PERTCalculator::analyzeClark", shape, tasks, edges,
+               measure(settings, [&] { PERTCalculator::analyzeClark(graph); }), tasks, "tasks/s");
+
+        const PERTSimulation simulation = PERTCalculator::analyzeSimulation(graph, options);
+        for (int correlationTerms : kClarkCorrelationTerms)
+        {
+            ClarkOptions clarkOptions;
+            clarkOptions.correlationTerms = correlationTerms;
+            clarkOptions.distributions = options.distributions;
+            reportClarkCheck(shape, tasks, correlationTerms, PERTCalculator::analyzeClark(graph, clarkOptions),
+                             simulation);
+        }
+    }
+
+    if (selected(settings, "PERTCalculator::analyzeSimulation", shape))
+    {
+        report("PERTCalculator::analyzeSimulation", shape, tasks, edges,
+               measure(settings, [&] { PERTCalculator::analyzeSimulation(graph, options); }),
+               options.numSimulations, "samples/s");
+    }
+}
+
+std::vector<int> parseSizes(const std::string& list)
+{
+    std::vector<int> sizes;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        sizes.push_back(std::stoi(item));
+    }
+    return sizes;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string option = argv[i];
+        const std::string value = argv[i + 1];
+        if (option == "--sizes")
+        {
+            settings.sizes = parseSizes(value);
+        }
+        else if (option == "--density")
+        {
+            settings.density = std::stoi(value);
+        }
+        else if (option == "--repetitions")
+        {
+            settings.repetitions = std::max(1, std::stoi(value));
+        }
+        else if (option == "--warmup")
+        {
+            settings.warmup = std::stoi(value);
+        }
+        else if (option == "--samples")
+        {
+            settings.samples = std::stoi(value);
+        }
+        else if (option == "--corpus")
+        {
+            settings.corpus = value;
+        }
+        else if (option == "--filter")
+        {
+            settings.filter = value;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << option << '\n';
+            return 2;
+        }
+    }
+
+    std::mt19937 rng(kSeed);
+    for (const char* shape : {"chain", "fan", "layered", "random"})
+    {
+        for (int tasks : settings.sizes)
+        {
+            const Project project = makeProject(shape, std::max(2, tasks), settings.density, rng);
+            writeProject(project, kCpmFile, kPertFile);
+            benchmarkCpm(settings, shape, kCpmFile);
+            benchmarkPert(settings, shape, kPertFile);
+        }
+    }
+    std::remove(kCpmFile);
+    std::remove(kPertFile);
+
+    std::error_code error;
+    std::vector<std::filesystem::path> corpus;
+    for (const auto& entry : std::filesystem::directory_iterator(settings.corpus, error))
+    {
+        corpus.push_back(entry.path());
+    }
+    std::sort(corpus.begin(), corpus.end());
+    for (const std::filesystem::path& path : corpus)
+    {
+        const ExpectedResults file = ExpectedResultsLoader::read_data(path.string());
+        if (file.format == ProjectFormat::Cpm)
+        {
+            benchmarkCpm(settings, path.filename().string(), path.string());
+        }
+        else if (file.format == ProjectFormat::Pert)
+        {
+            benchmarkPert(settings, path.filename().string(), path.string());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Schedule export throughput against the human-readable printer.
+//
+// Usage: ExportBenchmark [tasks] [repetitions]
+//
+// Builds a random layered CPM project, analyses it once and reports the best
+// time and output rate of ResultPrinter::printCPM and of ScheduleExporter in
+// every format, each writing to a temporary file.
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+
+#include "BenchmarkSupport.h"
+#include "CPMCalculator.h"
+#include "DataLoader.h"
+#include "ProjectGraph.h"
+#include "ResultPrinter.h"
+#include "ScheduleExporter.h"
+
+namespace
+{
+constexpr int kDefaultTasks = 1000000;
+constexpr int kDefaultRepetitions = 3;
+constexpr int kLayerWidth = 1000;
+constexpr int kFanIn = 3;
+constexpr const char* kOutputFile = "export_benchmark_output";
+
+ProjectData makeProject(int tasks)
+{
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> duration(1, 100);
+    std::uniform_int_distribution<int> slot(0, kLayerWidth - 1);
+
+    ProjectData data;
+    data.N = tasks;
+    for (int id = 1; id <= tasks; ++id)
+    {
+        Task& task = data.tasks.emplace_hint(data.tasks.end(), id, Task(id, duration(rng)))->second;
+        if (id <= kLayerWidth)
+        {
+            continue;
+        }
+        const int previousLayer = (id - 1) / kLayerWidth * kLayerWidth - kLayerWidth;
+        for (int k = 0; k < kFanIn; ++k)
+        {
+            const int pred = previousLayer + slot(rng) + 1;
+            task.predecessors.push_back(pred);
+            data.tasks.at(pred).successors.push_back(id);
+            ++data.M;
+        }
+    }
+    data.success = true;
+    return data;
+}
+
+template <typename Write>
+void benchmark(const char* name, int repetitions, const Write& write)
+{
+    long long bytes = 0;
+    const double best = BenchmarkSupport::bestMilliseconds(repetitions,
+                                                           [&]
+                                                           {
+                                                               std::ofstream file(kOutputFile, std::ios::binary);
+                                                               write(file);
+                                                               bytes = static_cast<long long>(file.tellp());
+                                                           });
+
+    std::cout << std::left << std::setw(26) << name
+              << std::right << std::setw(12) << best
+              << std::setw(12) << bytes / 1e6
+              << std::setw(12) << bytes / best / 1e3 << '\n';
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const int tasks = argc > 1 ? std::stoi(argv[1]) : kDefaultTasks;
+    const int repetitions = argc > 2 ? std::stoi(argv[2]) : kDefaultRepetitions;
+
+    ProjectData data = makeProject(tasks);
+    const ProjectGraph graph = ProjectGraph::compile(data.tasks);
+    ProjectSchedule<int> schedule;
+    const CPMResult result = CPMCalculator::analyze(graph, schedule);
+    CPMCalculator::analyze(data.tasks); // printCPM reads the times from the tasks
+
+    std::cout << "Tasks: " << graph.size() << ", best of " << repetitions << '\n'
+              << std::fixed << std::setprecision(1)
+              << std::left << std::setw(26) << "Writer"
+              << std::right << std::setw(12) << "ms"
+              << std::setw(12) << "MB"
+              << std::setw(12) << "MB/s" << '\n';
+
+    benchmark("ResultPrinter::printCPM", repetitions,
+              [&](std::ostream& output) { ResultPrinter::printCPM(data, result, output); });
+    benchmark("ScheduleExporter CSV", repetitions,
+              [&](std::ostream& output) { ScheduleExporter::write(graph, schedule, result, ExportFormat::Csv, output); });
+    benchmark("ScheduleExporter JSONL", repetitions,
+              [&](std::ostream& output)
+              { ScheduleExporter::write(graph, schedule, result, ExportFormat::JsonLines, output); });
+    benchmark("ScheduleExporter binary", repetitions,
+              [&](std::ostream& output)
+              { ScheduleExporter::write(graph, schedule, result, ExportFormat::Binary, output); });
+
+    std::remove(kOutputFile);
+    return 0;
+}
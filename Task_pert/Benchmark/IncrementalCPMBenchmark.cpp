@@ -0,0 +1,151 @@
+// Incremental CPM re-evaluation against a full CPMCalculator::analyze.
+//
+// Usage: IncrementalCPMBenchmark [tasks] [dependencies] [edits]
+//
+// Generates a random project (100k tasks by default), then applies `edits`
+// single-task duration changes through IncrementalCPM::update. For every edit
+// it records the update time and the cone, the tasks the two passes
+// re-evaluated, and prints them by cone size next to the time of a full
+// analysis. After every edit the total and, every kCheckInterval edits and
+// after the last one, the whole ES/EF/LS/LF/slack schedule are checked against
+// the full passes over the edited durations.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchmarkSupport.h"
+#include "CPMCalculator.h"
+#include "DataLoader.h"
+#include "IncrementalCPM.h"
+#include "LongestPath.h"
+#include "ProjectGraph.h"
+
+namespace
+{
+using BenchmarkSupport::bestMilliseconds;
+using BenchmarkSupport::writeCpmInput;
+
+constexpr const char* kFileName = "incremental_cpm_benchmark_input.txt";
+constexpr int kDefaultTasks = 100000;
+constexpr int kDefaultDependencies = 300000;
+constexpr int kDefaultEdits = 2000;
+constexpr int kCheckInterval = 100;
+constexpr int kRepetitions = 5;
+constexpr int kConeBuckets[] = {0, 10, 100, 1000, 10000, 100000}; // lower bounds of the cone-size rows
+
+struct Edit
+{
+    int cone = 0;
+    double milliseconds = 0.0;
+};
+
+bool sameSchedule(const ProjectSchedule<int>& lhs, const ProjectSchedule<int>& rhs)
+{
+    return lhs.ES == rhs.ES && lhs.EF == rhs.EF && lhs.LS == rhs.LS && lhs.LF == rhs.LF && lhs.slack == rhs.slack;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const int tasks = argc > 1 ? std::stoi(argv[1]) : kDefaultTasks;
+    const int dependencies = argc > 2 ? std::stoi(argv[2]) : kDefaultDependencies;
+    const int edits = argc > 3 ? std::stoi(argv[3]) : kDefaultEdits;
+
+    writeCpmInput(kFileName, tasks, dependencies);
+    ProjectData data = DataLoader::read_data(kFileName);
+    std::remove(kFileName);
+    if (!data.success)
+    {
+        std::cerr << "Error while reading the generated project\n";
+        return 1;
+    }
+    const ProjectGraph graph = ProjectGraph::compile(data.tasks);
+
+    ProjectSchedule<int> full;
+    const double fullTime = bestMilliseconds(kRepetitions, [&] { CPMCalculator::analyze(graph, full); });
+
+    IncrementalCPM incremental(graph);
+    std::vector<int> durations(graph.durations().begin(), graph.durations().end());
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> task(0, graph.size() - 1);
+    std::uniform_int_distribution<int> duration(1, 100);
+
+    std::vector<Edit> results;
+    results.reserve(edits);
+    int mismatches = 0;
+    for (int edit = 0; edit < edits; ++edit)
+    {
+        const int index = task(rng);
+        durations[index] = duration(rng);
+
+        const auto start = std::chrono::steady_clock::now();
+        const CPMResult result = incremental.update({{graph.taskId(index), durations[index]}});
+        const double elapsed =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        results.push_back({incremental.visitedTasks(), elapsed});
+
+        // The passes of CPMCalculator::analyze over the edited durations.
+        full.reset(graph.size());
+        const int total =
+            LongestPath::computeSchedule<LongestPath::Output::FullSchedule>(graph, ArrayView<int>(durations), full);
+        const bool checkSchedule = (edit + 1) % kCheckInterval == 0 || edit + 1 == edits;
+        if (result.totalDuration != total || (checkSchedule && !sameSchedule(incremental.schedule(), full)))
+        {
+            ++mismatches;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(4)
+              << "Project: " << graph.size() << " tasks, " << graph.edgeCount() << " dependencies, " << edits
+              << " single-task edits\n"
+              << "Full CPMCalculator::analyze: " << fullTime << " ms (best of " << kRepetitions << ")\n\n"
+              << std::left << std::setw(16) << "Cone [tasks]"
+              << std::right << std::setw(8) << "Edits"
+              << std::setw(12) << "Mean cone"
+              << std::setw(14) << "Mean [ms]"
+              << std::setw(14) << "ns / task"
+              << std::setw(12) << "vs full" << '\n';
+
+    constexpr int kBucketCount = static_cast<int>(sizeof(kConeBuckets) / sizeof(kConeBuckets[0]));
+    for (int bucket = 0; bucket < kBucketCount; ++bucket)
+    {
+        const int lower = kConeBuckets[bucket];
+        const int upper = bucket + 1 < kBucketCount ? kConeBuckets[bucket + 1] : graph.size() + 1;
+        int count = 0;
+        double cone = 0.0;
+        double time = 0.0;
+        for (const Edit& edit : results)
+        {
+            if (edit.cone >= lower && edit.cone < upper)
+            {
+                ++count;
+                cone += edit.cone;
+                time += edit.milliseconds;
+            }
+        }
+        if (count == 0)
+        {
+            continue;
+        }
+
+        const std::string label = std::to_string(lower) + " - " + std::to_string(upper - 1);
+        std::cout << std::left << std::setw(16) << label
+                  << std::right << std::setw(8) << count
+                  << std::setw(12) << std::setprecision(1) << cone / count
+                  << std::setw(14) << std::setprecision(4) << time / count
+                  << std::setw(14) << std::setprecision(1) << (cone > 0.0 ? time * 1e6 / cone : 0.0)
+                  << std::setw(11) << std::setprecision(1) << fullTime / (time / count) << 'x'
+                  << std::setprecision(4) << '\n';
+    }
+
+    std::cout << '\n' << (mismatches == 0 ? "Schedules identical to the full analysis"
+                                          : std::to_string(mismatches) + " edits differ from the full analysis")
+              << '\n';
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// Input parsing throughput of the loaders.
+//
+// Usage: LoaderBenchmark [tasks] [dependencies] [repetitions]
+//
+// Writes a synthetic CPM file (durations on one line, all dependencies on the
+// next) to a temporary path and reports the best time and throughput of
+//   - a std::stringstream scan of the numbers (what the loaders used to do),
+//   - a NumberScanner scan of the mapped file (the parsing core alone),
+//   - DataLoader::read_data (parsing plus building the task map) with 1, 2, 4,
+//     ... threads up to the core count.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "BenchmarkSupport.h"
+#include "DataLoader.h"
+#include "InputBuffer.h"
+#include "TextScanner.h"
+
+namespace
+{
+using BenchmarkSupport::bestMilliseconds;
+using BenchmarkSupport::writeCpmInput;
+
+constexpr int kDefaultTasks = 1000000;
+constexpr int kDefaultDependencies = 4000000;
+constexpr int kDefaultRepetitions = 3;
+constexpr const char* kFileName = "loader_benchmark_input.txt";
+
+void report(const char* name, double milliseconds, double bytes, long long checksum)
+{
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(12) << milliseconds
+              << std::setw(12) << bytes / milliseconds / 1e3
+              << std::setw(16) << checksum << '\n';
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const int tasks = argc > 1 ? std::stoi(argv[1]) : kDefaultTasks;
+    const int dependencies = argc > 2 ? std::stoi(argv[2]) : kDefaultDependencies;
+    const int repetitions = argc > 3 ? std::stoi(argv[3]) : kDefaultRepetitions;
+
+    writeCpmInput(kFileName, tasks, dependencies, "\n\nin:\n  - synthetic\n");
+    const double bytes = static_cast<double>(InputBuffer(kFileName).text().size());
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Input: " << tasks << " tasks, " << dependencies << " dependencies, "
+              << bytes / 1e6 << " MB, best of " << repetitions << "\n\n"
+              << std::left << std::setw(24) << "Parser"
+              << std::right << std::setw(12) << "Time [ms]"
+              << std::setw(12) << "MB/s"
+              << std::setw(16) << "Checksum" << '\n';
+
+    long long checksum = 0;
+    const double streamTime = bestMilliseconds(repetitions,
+                                               [&]
+                                               {
+                                                   checksum = 0;
+                                                   std::ifstream file(kFileName);
+                                                   std::string line;
+                                                   while (std::getline(file, line))
+                                                   {
+                                                       std::stringstream ss(line);
+                                                       int value;
+                                                       while (ss >> value)
+                                                       {
+                                                           checksum += value;
+                                                       }
+                                                   }
+                                               });
+    report("stringstream", streamTime, bytes, checksum);
+
+    const double scanTime = bestMilliseconds(repetitions,
+                                             [&]
+                                             {
+                                                 checksum = 0;
+                                                 const InputBuffer input(kFileName);
+                                                 LineScanner lines(input.text());
+                                                 std::string_view line;
+                                                 while (lines.next(line))
+                                                 {
+                                                     NumberScanner numbers(line);
+                                                     int value;
+                                                     while (numbers.read(value))
+                                                     {
+                                                         checksum += value;
+                                                     }
+                                                 }
+                                             });
+    report("NumberScanner", scanTime, bytes, checksum);
+
+    const int hardwareThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= hardwareThreads; threads *= 2)
+    {
+        LoadOptions options;
+        options.threadCount = threads;
+        const double loadTime = bestMilliseconds(repetitions,
+                                                 [&]
+                                                 {
+                                                     const ProjectData data = DataLoader::read_data(kFileName, options);
+                                                     checksum = static_cast<long long>(data.tasks.size());
+                                                 });
+        const std::string name = "read_data, " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        report(name.c_str(), loadTime, bytes, checksum);
+    }
+
+    std::remove(kFileName);
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Level-synchronous parallel CPM against the sequential Kahn-order passes.
+//
+// Usage: ParallelCPMBenchmark [threads] [repetitions]
+//
+// Builds synthetic wide graphs (one source fanning out to many parallel tasks
+// joined by one sink, and layered graphs with random edges between adjacent
+// layers), runs CPMCalculator::analyze and analyzeParallel on each and prints
+// the best time of both and the speedup. Every parallel schedule is checked
+// against the sequential one.
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+
+#include "BenchmarkSupport.h"
+#include "CPMCalculator.h"
+#include "ProjectGraph.h"
+#include "ThreadPool.h"
+
+namespace
+{
+using BenchmarkSupport::bestMilliseconds;
+
+constexpr int kDefaultRepetitions = 5;
+constexpr int kLayerFanIn = 3;
+
+// One source, `width` parallel tasks and one sink.
+std::map<int, Task> makeFan(int width, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> duration(1, 100);
+    std::map<int, Task> tasks;
+    const int sink = width + 1;
+    tasks[0] = Task(0, duration(rng));
+    tasks[sink] = Task(sink, duration(rng));
+    for (int id = 1; id <= width; ++id)
+    {
+        tasks[id] = Task(id, duration(rng));
+        tasks[id].predecessors.push_back(0);
+        tasks[id].successors.push_back(sink);
+        tasks[0].successors.push_back(id);
+        tasks[sink].predecessors.push_back(id);
+    }
+    return tasks;
+}
+
+// `layers` layers of `width` tasks; each task depends on kLayerFanIn random
+// tasks of the layer before it.
+std::map<int, Task> makeLayered(int layers, int width, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> duration(1, 100);
+    std::uniform_int_distribution<int> column(0, width - 1);
+    std::map<int, Task> tasks;
+    for (int layer = 0; layer < layers; ++layer)
+    {
+        for (int c = 0; c < width; ++c)
+        {
+            const int id = layer * width + c;
+            tasks[id] = Task(id, duration(rng));
+            if (layer == 0)
+            {
+                continue;
+            }
+            for (int k = 0; k < kLayerFanIn; ++k)
+            {
+                const int predecessor = (layer - 1) * width + column(rng);
+                std::vector<int>& predecessors = tasks[id].predecessors;
+                if (std::find(predecessors.begin(), predecessors.end(), predecessor) == predecessors.end())
+                {
+                    predecessors.push_back(predecessor);
+                    tasks[predecessor].successors.push_back(id);
+                }
+            }
+        }
+    }
+    return tasks;
+}
+
+bool sameSchedule(const ProjectSchedule<int>& lhs, const ProjectSchedule<int>& rhs)
+{
+    return lhs.ES == rhs.ES && lhs.EF == rhs.EF && lhs.LS == rhs.LS && lhs.LF == rhs.LF && lhs.slack == rhs.slack;
+}
+
+bool run(const std::string& name, const std::map<int, Task>& tasks, ThreadPool& pool, int repetitions)
+{
+    const ProjectGraph graph = ProjectGraph::compile(tasks);
+
+    ProjectSchedule<int> sequential;
+    ProjectSchedule<int> parallel;
+    CPMResult sequentialResult;
+    CPMResult parallelResult;
+    const double sequentialTime = bestMilliseconds(repetitions, [&] { sequentialResult = CPMCalculator::analyze(graph, sequential); });
+    const double parallelTime = bestMilliseconds(repetitions, [&] { parallelResult = CPMCalculator::analyzeParallel(graph, parallel, pool); });
+
+    const bool identical = sequentialResult.totalDuration == parallelResult.totalDuration &&
+                           sequentialResult.criticalPath == parallelResult.criticalPath &&
+                           sameSchedule(sequential, parallel);
+
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(10) << graph.size()
+              << std::setw(8) << graph.levelCount()
+              << std::setw(14) << sequentialTime
+              << std::setw(14) << parallelTime
+              << std::setw(9) << sequentialTime / parallelTime << 'x'
+              << (identical ? "" : "  MISMATCH") << '\n';
+    return identical;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const int threads = argc > 1 ? std::stoi(argv[1]) : 0;
+    const int repetitions = argc > 2 ? std::stoi(argv[2]) : kDefaultRepetitions;
+
+    ThreadPool pool(threads);
+    std::mt19937 rng(12345);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Threads: " << pool.threadCount() << ", best of " << repetitions << "\n\n"
+              << std::left << std::setw(28) << "Graph"
+              << std::right << std::setw(10) << "Tasks"
+              << std::setw(8) << "Levels"
+              << std::setw(14) << "Seq [ms]"
+              << std::setw(14) << "Par [ms]"
+              << std::setw(10) << "Speedup" << '\n';
+
+    bool identical = true;
+    identical &= run("fan 1M", makeFan(1000000, rng), pool, repetitions);
+    identical &= run("fan 4M", makeFan(4000000, rng), pool, repetitions);
+    identical &= run("layered 16 x 65536", makeLayered(16, 65536, rng), pool, repetitions);
+    identical &= run("layered 64 x 32768", makeLayered(64, 32768, rng), pool, repetitions);
+    identical &= run("layered 1024 x 256 (narrow)", makeLayered(1024, 256, rng), pool, repetitions);
+
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+// Convergence of the sampling schemes against plain pseudo-random sampling.
+//
+// Usage: SamplingBenchmark [pert_file] [replications]
+//
+// Estimates a reference mean, on-time probability and percentile with a long
+// pseudo-random run, then repeats short runs of every scheme with different
+// seeds and prints their root-mean-square error per sample size. The gain
+// columns are the variance reduction against Random at the same sample size,
+// i.e. how many times more pseudo-random samples give the same error, for
+// each of the three estimates.
+//
+// The targets are the file's target time and probability. A target the
+// reference run puts at P = 0 or 1, or a percentile at the smallest or largest
+// completion time, has no sampling error to measure, so the reference mean
+// and the median take their place.
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "DataLoader_pert.h"
+#include "PERTCalculator.h"
+#include "ProjectGraph.h"
+
+namespace
+{
+constexpr const char* kDefaultPertFile = "problem_data/pert_data_2.txt";
+constexpr int kDefaultReplications = 32;
+constexpr int kReferenceSimulations = 16000000;
+constexpr std::uint64_t kReferenceSeed = 987654321;
+
+constexpr double kMedian = 50.0;
+
+struct Estimates
+{
+    double mean = 0.0;
+    double probability = 0.0;
+    double percentile = 0.0;
+};
+
+PERTSimulation simulate(const ProjectGraph& graph, SamplingScheme scheme, int simulations, std::uint64_t seed)
+{
+    SimulationOptions options;
+    options.numSimulations = simulations;
+    options.sampling = scheme;
+    options.seed = seed;
+    options.hasSeed = true;
+    return PERTCalculator::analyzeSimulation(graph, options);
+}
+
+Estimates estimate(const PERTSimulation& result, double targetTime, double targetPercentile)
+{
+    return {result.meanDuration, result.getProbabilityWithin(targetTime), result.getPercentile(targetPercentile)};
+}
+
+// Squared RMSE ratio; "inf" when only the scheme hits the reference exactly,
+// "-" when both do (nothing to compare).
+void printGain(double randomError, double error)
+{
+    if (error > 0.0)
+    {
+        std::cout << std::setw(11) << std::setprecision(1) << (randomError / error) * (randomError / error) << 'x'
+                  << std::setprecision(4);
+        return;
+    }
+    std::cout << std::setw(12) << (randomError > 0.0 ? "inf" : "-");
+}
+
+bool parseReplications(const char* text, int& replications)
+{
+    const char* end = text + std::strlen(text);
+    const std::from_chars_result result = std::from_chars(text, end, replications);
+    return result.ec == std::errc() && result.ptr == end && text != end && replications > 0;
+}
+
+const char* schemeName(SamplingScheme scheme)
+{
+    switch (scheme)
+    {
+    case SamplingScheme::Random:
+        return "Random";
+    case SamplingScheme::Antithetic:
+        return "Antithetic";
+    case SamplingScheme::LatinHypercube:
+        return "LatinHypercube";
+    case SamplingScheme::Sobol:
+        return "Sobol";
+    }
+    return "?";
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string pertFile = argc > 1 ? argv[1] : kDefaultPertFile;
+    int replications = kDefaultReplications;
+    if (argc > 2 && !parseReplications(argv[2], replications))
+    {
+        std::cerr << "Usage: " << argv[0] << " [pert_file] [replications]\n";
+        return 2;
+    }
+
+    ProjectDataPert pertData = DataLoader_pert::read_data(pertFile);
+    if (!pertData.success)
+    {
+        std::cerr << "Error while reading pert data: " << pertFile << '\n';
+        return 1;
+    }
+
+    const ProjectGraph graph = ProjectGraph::compile(pertData.tasks);
+    const PERTSimulation referenceRun =
+        simulate(graph, SamplingScheme::Random, kReferenceSimulations, kReferenceSeed);
+
+    double targetTime = pertData.target_time;
+    double targetPercentile = pertData.target_probability * 100.0;
+    const double targetProbability = referenceRun.getProbabilityWithin(targetTime);
+    if (targetProbability <= 0.0 || targetProbability >= 1.0)
+    {
+        targetTime = referenceRun.meanDuration;
+    }
+    const double percentile = referenceRun.getPercentile(targetPercentile);
+    if (percentile <= referenceRun.minDuration || percentile >= referenceRun.maxDuration)
+    {
+        targetPercentile = kMedian;
+    }
+    const Estimates reference = estimate(referenceRun, targetTime, targetPercentile);
+
+    std::cout << std::fixed << std::setprecision(4)
+              << "File: " << pertFile << " (" << graph.size() << " tasks), " << replications << " replications\n"
+              << "Reference (" << kReferenceSimulations << " samples): mean " << reference.mean
+              << ", P(T <= " << targetTime << ") " << reference.probability
+              << ", P" << targetPercentile << ' ' << reference.percentile << "\n\n";
+
+    std::cout << std::left << std::setw(16) << "Scheme"
+              << std::right << std::setw(9) << "Samples"
+              << std::setw(12) << "RMSE mean"
+              << std::setw(12) << "RMSE prob"
+              << std::setw(12) << "RMSE pct"
+              << std::setw(12) << "Gain mean"
+              << std::setw(12) << "Gain prob"
+              << std::setw(12) << "Gain pct" << '\n';
+
+    const SamplingScheme schemes[] = {SamplingScheme::Random, SamplingScheme::Antithetic,
+                                      SamplingScheme::LatinHypercube, SamplingScheme::Sobol};
+    for (int simulations : {1024, 4096, 16384, 65536})
+    {
+        Estimates randomError;
+        for (SamplingScheme scheme : schemes)
+        {
+            double meanError = 0.0;
+            double probabilityError = 0.0;
+            double percentileError = 0.0;
+            for (int replication = 0; replication < replications; ++replication)
+            {
+                const Estimates run = estimate(simulate(graph, scheme, simulations, replication + 1), targetTime,
+                                               targetPercentile);
+                meanError += (run.mean - reference.mean) * (run.mean - reference.mean);
+                probabilityError += (run.probability - reference.probability) * (run.probability - reference.probability);
+                percentileError += (run.percentile - reference.percentile) * (run.percentile - reference.percentile);
+            }
+            meanError = std::sqrt(meanError / replications);
+            probabilityError = std::sqrt(probabilityError / replications);
+            percentileError = std::sqrt(percentileError / replications);
+            if (scheme == SamplingScheme::Random)
+            {
+                randomError = {meanError, probabilityError, percentileError};
+            }
+
+            std::cout << std::left << std::setw(16) << schemeName(scheme)
+                      << std::right << std::setw(9) << simulations
+                      << std::setw(12) << meanError
+                      << std::setw(12) << probabilityError
+                      << std::setw(12) << percentileError;
+            printGain(randomError.mean, meanError);
+            printGain(randomError.probability, probabilityError);
+            printGain(randomError.percentile, percentileError);
+            std::cout << '\n';
+        }
+        std::cout << '\n';
+    }
+
+    return 0;
+}
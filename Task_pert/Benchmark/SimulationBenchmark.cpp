@@ -0,0 +1,126 @@
+// Compares the scalar and lane-batched Monte Carlo kernels.
+//
+// Usage: SimulationBenchmark [pert_file] [simulations]
+//
+// Runs both kernels single-threaded with the same seed on the given PERT file
+// and on generated layered graphs, checks that they produce identical
+// completion times and prints the timings and speedup.
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DataLoader_pert.h"
+#include "MonteCarloEngine.h"
+#include "PERTCalculator.h"
+#include "ProjectGraph.h"
+
+namespace
+{
+constexpr const char* kDefaultPertFile = "problem_data/pert_data_3.txt";
+constexpr int kDefaultSimulations = 200000;
+constexpr std::uint64_t kSeed = 12345;
+
+// Layered DAG: `layers` layers of `width` tasks, each task depending on up to
+// `fanIn` random tasks of the previous layer.
+std::map<int, Task_pert> makeLayeredProject(int layers, int width, int fanIn, std::uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> optimisticDist(1, 20);
+    std::uniform_int_distribution<int> spreadDist(0, 20);
+    std::uniform_int_distribution<int> pickDist(0, width - 1);
+
+    std::map<int, Task_pert> tasks;
+    for (int layer = 0; layer < layers; ++layer)
+    {
+        for (int slot = 0; slot < width; ++slot)
+        {
+            const int id = layer * width + slot + 1;
+            const int optimistic = optimisticDist(gen);
+            const int likely = optimistic + spreadDist(gen);
+            const int pessimistic = likely + spreadDist(gen);
+            tasks.emplace(id, Task_pert(id, optimistic, likely, pessimistic));
+
+            if (layer == 0)
+            {
+                continue;
+            }
+            for (int k = 0; k < fanIn; ++k)
+            {
+                const int predecessorId = (layer - 1) * width + pickDist(gen) + 1;
+                Task_pert& task = tasks.at(id);
+                if (std::find(task.predecessors.begin(), task.predecessors.end(), predecessorId) == task.predecessors.end())
+                {
+                    task.predecessors.push_back(predecessorId);
+                    tasks.at(predecessorId).successors.push_back(id);
+                }
+            }
+        }
+    }
+    return tasks;
+}
+
+double runKernel(const ProjectGraph& graph, int simulations, SimulationKernel kernel, PERTSimulation& result)
+{
+    SimulationOptions options;
+    options.numSimulations = simulations;
+    options.kernel = kernel;
+    options.threadCount = 1;
+    options.seed = kSeed;
+    options.hasSeed = true;
+
+    const auto start = std::chrono::steady_clock::now();
+    result = PERTCalculator::analyzeSimulation(graph, options);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void benchmark(const std::string& name, const ProjectGraph& graph, int simulations)
+{
+    PERTSimulation scalar;
+    PERTSimulation batched;
+    const double scalarMs = runKernel(graph, simulations, SimulationKernel::Scalar, scalar);
+    const double batchedMs = runKernel(graph, simulations, SimulationKernel::LaneBatched, batched);
+
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(9) << graph.size()
+              << std::setw(10) << graph.edgeCount()
+              << std::setw(12) << scalarMs
+              << std::setw(12) << batchedMs
+              << std::setw(9) << scalarMs / batchedMs << 'x'
+              << (scalar.completionTimes == batched.completionTimes ? "  identical" : "  MISMATCH")
+              << '\n';
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string pertFile = argc > 1 ? argv[1] : kDefaultPertFile;
+    const int simulations = argc > 2 ? std::stoi(argv[2]) : kDefaultSimulations;
+
+    std::cout << "Lane width: " << MonteCarloEngine::kLaneCount << ", simulations: " << simulations << "\n\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << std::left << std::setw(28) << "Graph"
+              << std::right << std::setw(9) << "Tasks"
+              << std::setw(10) << "Edges"
+              << std::setw(12) << "Scalar ms"
+              << std::setw(12) << "Batched ms"
+              << std::setw(10) << "Speedup" << '\n';
+
+    ProjectDataPert pertData = DataLoader_pert::read_data(pertFile);
+    if (pertData.success)
+    {
+        benchmark(pertFile, ProjectGraph::compile(pertData.tasks), simulations);
+    }
+
+    benchmark("layered 20x50, fan-in 3", ProjectGraph::compile(makeLayeredProject(20, 50, 3, 1)), simulations);
+    benchmark("layered 100x100, fan-in 4", ProjectGraph::compile(makeLayeredProject(100, 100, 4, 2)), simulations / 10);
+    benchmark("layered 200x500, fan-in 4", ProjectGraph::compile(makeLayeredProject(200, 500, 4, 3)), simulations / 100);
+
+    return 0;
+}
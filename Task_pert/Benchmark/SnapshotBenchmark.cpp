@@ -0,0 +1,77 @@
+// Opening a project from its binary snapshot against parsing the text file.
+//
+// Usage: SnapshotBenchmark [tasks] [dependencies] [repetitions]
+//
+// Writes a synthetic CPM text file, converts it to a snapshot and reports the
+// best time of DataLoader::read_data + ProjectGraph::compile against
+// SnapshotLoader::read_data, then checks that CPM gives the same schedule on
+// both graphs.
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "BenchmarkSupport.h"
+#include "CPMCalculator.h"
+#include "DataLoader.h"
+#include "ProjectGraph.h"
+#include "ProjectSnapshot.h"
+
+namespace
+{
+using BenchmarkSupport::bestMilliseconds;
+using BenchmarkSupport::writeCpmInput;
+
+constexpr int kDefaultTasks = 1000000;
+constexpr int kDefaultDependencies = 10000000;
+constexpr int kDefaultRepetitions = 3;
+constexpr const char* kTextFile = "snapshot_benchmark_input.txt";
+constexpr const char* kSnapshotFile = "snapshot_benchmark_input.snapshot";
+
+}
+
+int main(int argc, char* argv[])
+{
+    const int tasks = argc > 1 ? std::stoi(argv[1]) : kDefaultTasks;
+    const int dependencies = argc > 2 ? std::stoi(argv[2]) : kDefaultDependencies;
+    const int repetitions = argc > 3 ? std::stoi(argv[3]) : kDefaultRepetitions;
+
+    writeCpmInput(kTextFile, tasks, dependencies);
+    if (!SnapshotLoader::write_data(kSnapshotFile, DataLoader::read_data(kTextFile)))
+    {
+        return 1;
+    }
+
+    ProjectGraph textGraph;
+    const double textTime = bestMilliseconds(repetitions,
+                                             [&]
+                                             {
+                                                 const ProjectData data = DataLoader::read_data(kTextFile);
+                                                 textGraph = ProjectGraph::compile(data.tasks);
+                                             });
+
+    ProjectSnapshot snapshot;
+    const double snapshotTime = bestMilliseconds(repetitions,
+                                                 [&] { snapshot = SnapshotLoader::read_data(kSnapshotFile); });
+
+    ProjectSchedule<int> textSchedule;
+    ProjectSchedule<int> snapshotSchedule;
+    const CPMResult textResult = CPMCalculator::analyze(textGraph, textSchedule);
+    const CPMResult snapshotResult = CPMCalculator::analyze(snapshot.graph, snapshotSchedule);
+    const bool identical = snapshot.success && textResult.totalDuration == snapshotResult.totalDuration &&
+                           textResult.criticalPath == snapshotResult.criticalPath &&
+                           textSchedule.ES == snapshotSchedule.ES && textSchedule.LS == snapshotSchedule.LS;
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Input: " << tasks << " tasks, " << snapshot.graph.edgeCount() << " dependencies, best of "
+              << repetitions << '\n'
+              << "Text (read_data + compile): " << std::setw(12) << textTime << " ms\n"
+              << "Snapshot (read_data):       " << std::setw(12) << snapshotTime << " ms\n"
+              << "CPM results " << (identical ? "identical" : "DIFFER") << '\n';
+
+    std::remove(kTextFile);
+    snapshot = ProjectSnapshot();
+    std::remove(kSnapshotFile);
+    return identical ? 0 : 1;
+}
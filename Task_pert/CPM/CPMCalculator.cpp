@@ -1,194 +1,139 @@
 #include "CPMCalculator.h"
+#include "LevelScheduler.h"
+#include "LongestPath.h"
 
 #include <algorithm>
 #include <limits>
 
 namespace
 {
-void initializeStartTimes(std::map<int, Task>& tasks,
-                          std::map<int, int>& inDegree,
-                          std::vector<int>& topoOrder)
+void storeSchedule(const ProjectSchedule<int>& schedule, std::map<int, Task>& tasks)
 {
-    topoOrder.clear();
-    inDegree.clear();
-
+    std::size_t index = 0;
     for (auto& [id, task] : tasks)
     {
-        inDegree[id] = static_cast<int>(task.predecessors.size());
-        task.ES = 0;
-        task.EF = 0;
-        task.LS = 0;
-        task.LF = 0;
-        task.slack = 0;
+        task.ES = schedule.ES[index];
+        task.EF = schedule.EF[index];
+        task.LS = schedule.LS[index];
+        task.LF = schedule.LF[index];
+        task.slack = schedule.slack[index];
+        ++index;
+    }
+}
 
-        if (inDegree[id] == 0)
-        {
-            task.ES = 0;
-            task.EF = task.duration;
-            topoOrder.push_back(id);
-        }
+void extractCriticalPath(const ProjectGraph& graph,
+                         const ProjectSchedule<int>& schedule,
+                         CPMResult& result)
+{
+    for (int index : LongestPath::criticalChain(graph, schedule))
+    {
+        result.criticalPath.push_back(graph.taskId(index));
     }
 }
 }
 
 CPMResult CPMCalculator::analyze(std::map<int, Task>& tasks)
 {
-    CPMResult result;
     if (tasks.empty())
     {
-        return result;
-    }
-
-    std::map<int, int> inDegree;
-    std::vector<int> topoOrder;
-    initializeStartTimes(tasks, inDegree, topoOrder);
-
-    // Forward pass.
-    std::size_t head = 0;
-    while (head < topoOrder.size())
-    {
-        const int currentId = topoOrder[head++];
-        Task& currentTask = tasks.at(currentId);
-        currentTask.EF = currentTask.ES + currentTask.duration;
-
-        for (int successorId : currentTask.successors)
-        {
-            Task& successor = tasks.at(successorId);
-            successor.ES = std::max(successor.ES, currentTask.EF);
-
-            auto it = inDegree.find(successorId);
-            if (it != inDegree.end() && --(it->second) == 0)
-            {
-                topoOrder.push_back(successorId);
-            }
-        }
+        return {};
     }
 
-    // Determine total project duration.
-    for (const auto& [id, task] : tasks)
-    {
-        if (task.successors.empty())
-        {
-            result.totalDuration = std::max(result.totalDuration, task.EF);
-        }
-    }
+    const ProjectGraph graph = ProjectGraph::compile(tasks);
+    ProjectSchedule<int> schedule;
+    CPMResult result = analyze(graph, schedule);
+    storeSchedule(schedule, tasks);
+    return result;
+}
 
-    // Backward pass.
-    for (auto& [id, task] : tasks)
+CPMResult CPMCalculator::analyze(const ProjectGraph& graph, ProjectSchedule<int>& schedule)
+{
+    CPMResult result;
+    const int taskCount = graph.size();
+    schedule.reset(taskCount);
+    if (taskCount == 0)
     {
-        if (task.successors.empty())
-        {
-            task.LF = result.totalDuration;
-        }
+        return result;
     }
 
-    for (int i = static_cast<int>(topoOrder.size()) - 1; i >= 0; --i)
-    {
-        const int currentId = topoOrder[i];
-        Task& currentTask = tasks.at(currentId);
-
-        if (!currentTask.successors.empty())
-        {
-            int minLateStart = result.totalDuration;
-            bool first = true;
-            for (int successorId : currentTask.successors)
-            {
-                const Task& successor = tasks.at(successorId);
-                if (first || successor.LS < minLateStart)
-                {
-                    minLateStart = successor.LS;
-                    first = false;
-                }
-            }
-            currentTask.LF = minLateStart;
-        }
-
-        currentTask.LS = currentTask.LF - currentTask.duration;
-        currentTask.slack = currentTask.LF - currentTask.EF;
-    }
+    result.totalDuration =
+        LongestPath::computeSchedule<LongestPath::Output::FullSchedule>(graph, graph.durations(), schedule);
+    extractCriticalPath(graph, schedule, result);
+    return result;
+}
 
-    std::vector<int> criticalCandidates;
-    criticalCandidates.reserve(tasks.size());
-    for (const auto& [id, task] : tasks)
+CPMResult CPMCalculator::analyzeParallel(const ProjectGraph& graph, ProjectSchedule<int>& schedule, ThreadPool& pool)
+{
+    if (!LevelScheduler::worthParallel(graph, pool))
     {
-        if (task.slack == 0)
-        {
-            criticalCandidates.push_back(id);
-        }
+        return analyze(graph, schedule);
     }
 
-    std::sort(criticalCandidates.begin(), criticalCandidates.end(),
-              [&tasks](int lhs, int rhs)
-              {
-                  return tasks.at(lhs).ES < tasks.at(rhs).ES;
-              });
+    CPMResult result;
+    schedule.reset(graph.size());
+    result.totalDuration = LevelScheduler::computeSchedule(graph, graph.durations(), schedule, pool);
+    extractCriticalPath(graph, schedule, result);
+    return result;
+}
 
-    if (!criticalCandidates.empty())
+CPMResult CPMCalculator::analyzeBellmanFord(std::map<int, Task>& tasks)
+{
+    if (tasks.empty())
     {
-        result.criticalPath.push_back(criticalCandidates.front());
-        for (std::size_t idx = 1; idx < criticalCandidates.size(); ++idx)
-        {
-            const int currentId = criticalCandidates[idx];
-            const int previousId = result.criticalPath.back();
-            const Task& previousTask = tasks.at(previousId);
-            const auto successorIt = std::find(previousTask.successors.begin(), previousTask.successors.end(), currentId);
-            if (successorIt != previousTask.successors.end())
-            {
-                result.criticalPath.push_back(currentId);
-            }
-        }
+        return {};
     }
 
+    const ProjectGraph graph = ProjectGraph::compile(tasks);
+    ProjectSchedule<int> schedule;
+    CPMResult result = analyzeBellmanFord(graph, schedule);
+    storeSchedule(schedule, tasks);
     return result;
 }
 
-CPMResult CPMCalculator::analyzeBellmanFord(std::map<int, Task>& tasks)
+CPMResult CPMCalculator::analyzeBellmanFord(const ProjectGraph& graph, ProjectSchedule<int>& schedule)
 {
     CPMResult result;
-    if (tasks.empty())
+    const int vertices = graph.size();
+    schedule.reset(vertices);
+    if (vertices == 0)
     {
         return result;
     }
 
     constexpr int negativeInfinity = std::numeric_limits<int>::min() / 4;
+    const ArrayView<int> durations = graph.durations();
 
-    for (auto& [id, task] : tasks)
+    for (int i = 0; i < vertices; ++i)
     {
-        if (task.predecessors.empty())
+        if (graph.isSource(i))
         {
-            task.ES = 0;
-            task.EF = task.duration;
+            schedule.ES[i] = 0;
+            schedule.EF[i] = durations[i];
         }
         else
         {
-            task.ES = negativeInfinity;
-            task.EF = negativeInfinity;
+            schedule.ES[i] = negativeInfinity;
+            schedule.EF[i] = negativeInfinity;
         }
-        task.LS = 0;
-        task.LF = 0;
-        task.slack = 0;
     }
 
-    const int vertices = static_cast<int>(tasks.size());
-
     for (int iteration = 0; iteration < vertices - 1; ++iteration)
     {
         bool updated = false;
-        for (auto& [id, task] : tasks)
+        for (int i = 0; i < vertices; ++i)
         {
-            if (task.ES == negativeInfinity)
+            if (schedule.ES[i] == negativeInfinity)
             {
                 continue;
             }
 
-            const int finish = task.ES + task.duration;
-            for (int successorId : task.successors)
+            const int finish = schedule.ES[i] + durations[i];
+            for (int successor : graph.successors(i))
             {
-                Task& successor = tasks.at(successorId);
-                if (finish > successor.ES)
+                if (finish > schedule.ES[successor])
                 {
-                    successor.ES = finish;
-                    successor.EF = successor.ES + successor.duration;
+                    schedule.ES[successor] = finish;
+                    schedule.EF[successor] = finish + durations[successor];
                     updated = true;
                 }
             }
@@ -200,42 +145,34 @@ CPMResult CPMCalculator::analyzeBellmanFord(std::map<int, Task>& tasks)
         }
     }
 
-    for (auto& [id, task] : tasks)
-    {
-        if (task.ES == negativeInfinity)
-        {
-            task.ES = 0;
-        }
-        task.EF = task.ES + task.duration;
-    }
-
-    for (const auto& [id, task] : tasks)
+    for (int i = 0; i < vertices; ++i)
     {
-        if (task.EF > result.totalDuration)
+        if (schedule.ES[i] == negativeInfinity)
         {
-            result.totalDuration = task.EF;
+            schedule.ES[i] = 0;
         }
+        schedule.EF[i] = schedule.ES[i] + durations[i];
+        result.totalDuration = std::max(result.totalDuration, schedule.EF[i]);
     }
 
-    for (auto& [id, task] : tasks)
+    for (int i = 0; i < vertices; ++i)
     {
-        task.LF = result.totalDuration;
-        task.LS = task.LF - task.duration;
+        schedule.LF[i] = result.totalDuration;
+        schedule.LS[i] = schedule.LF[i] - durations[i];
     }
 
     for (int iteration = 0; iteration < vertices - 1; ++iteration)
     {
         bool updated = false;
-        for (auto& [id, task] : tasks)
+        for (int i = 0; i < vertices; ++i)
         {
-            for (int successorId : task.successors)
+            for (int successor : graph.successors(i))
             {
-                Task& successor = tasks.at(successorId);
-                const int candidateLF = successor.LS;
-                if (candidateLF < task.LF)
+                const int candidateLF = schedule.LS[successor];
+                if (candidateLF < schedule.LF[i])
                 {
-                    task.LF = candidateLF;
-                    task.LS = task.LF - task.duration;
+                    schedule.LF[i] = candidateLF;
+                    schedule.LS[i] = candidateLF - durations[i];
                     updated = true;
                 }
             }
@@ -247,40 +184,11 @@ CPMResult CPMCalculator::analyzeBellmanFord(std::map<int, Task>& tasks)
         }
     }
 
-    std::vector<int> criticalCandidates;
-    criticalCandidates.reserve(tasks.size());
-    for (auto& [id, task] : tasks)
+    for (int i = 0; i < vertices; ++i)
     {
-        task.slack = task.LF - task.EF;
-        if (task.slack == 0)
-        {
-            criticalCandidates.push_back(id);
-        }
-    }
-
-    std::sort(criticalCandidates.begin(), criticalCandidates.end(),
-              [&tasks](int lhs, int rhs)
-              {
-                  return tasks.at(lhs).ES < tasks.at(rhs).ES;
-              });
-
-    if (!criticalCandidates.empty())
-    {
-        result.criticalPath.push_back(criticalCandidates.front());
-        for (std::size_t idx = 1; idx < criticalCandidates.size(); ++idx)
-        {
-            const int currentId = criticalCandidates[idx];
-            const int previousId = result.criticalPath.back();
-            const Task& previousTask = tasks.at(previousId);
-            const auto successorIt = std::find(previousTask.successors.begin(),
-                                               previousTask.successors.end(),
-                                               currentId);
-            if (successorIt != previousTask.successors.end())
-            {
-                result.criticalPath.push_back(currentId);
-            }
-        }
+        schedule.slack[i] = schedule.LF[i] - schedule.EF[i];
     }
 
+    extractCriticalPath(graph, schedule, result);
     return result;
-}
\ No newline at end of file
+}
@@ -4,8 +4,11 @@
 #include <map>
 #include <vector>
 
+#include "ProjectGraph.h"
 #include "Task.h"
 
+class ThreadPool;
+
 struct CPMResult
 {
     int totalDuration = 0;
@@ -17,6 +20,13 @@ class CPMCalculator
 public:
     static CPMResult analyze(std::map<int, Task>& tasks);
     static CPMResult analyzeBellmanFord(std::map<int, Task>& tasks);
+
+    // Graph-based variants; the schedule is resized to graph.size() and indexed like the graph.
+    static CPMResult analyze(const ProjectGraph& graph, ProjectSchedule<int>& schedule);
+    static CPMResult analyzeBellmanFord(const ProjectGraph& graph, ProjectSchedule<int>& schedule);
+
+    // Same result as analyze; wide graphs run the passes level by level on `pool`.
+    static CPMResult analyzeParallel(const ProjectGraph& graph, ProjectSchedule<int>& schedule, ThreadPool& pool);
 };
 
 #endif // CPM_CALCULATOR_H
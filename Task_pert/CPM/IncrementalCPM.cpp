@@ -0,0 +1,216 @@
+#include "IncrementalCPM.h"
+
+#include <algorithm>
+
+IncrementalCPM::IncrementalCPM(const ProjectGraph& graph)
+    : graph_(&graph)
+{
+    const int taskCount = graph.size();
+    durations_.assign(graph.durations().begin(), graph.durations().end());
+    queued_.assign(taskCount, 0);
+    edited_.assign(taskCount, 0);
+
+    position_.assign(taskCount, -1);
+    const ArrayView<int> topoOrder = graph.topologicalOrder();
+    for (std::size_t position = 0; position < topoOrder.size(); ++position)
+    {
+        position_[topoOrder[position]] = static_cast<int>(position);
+    }
+
+    ProjectSchedule<int> initial;
+    CPMCalculator::analyze(graph, initial);
+    earlyStart_ = initial.ES;
+
+    // Tails by a backward pass of their own rather than from initial.LS, which
+    // analyze pins to 0 in front of tasks off the topological order.
+    tail_.assign(taskCount, 0);
+    for (auto it = topoOrder.end(); it != topoOrder.begin();)
+    {
+        const int current = *--it;
+        tail_[current] = durations_[current] + longestSuccessorTail(current);
+        if (graph.isSource(current))
+        {
+            sourceTails_.emplace(-tail_[current], current);
+        }
+    }
+}
+
+int IncrementalCPM::lateFinish(int index) const
+{
+    if (scheduled(index))
+    {
+        return lateStart(index) + durations_[index];
+    }
+    return graph_->isSink(index) ? totalDuration() : 0;
+}
+
+int IncrementalCPM::longestSuccessorTail(int index) const
+{
+    int longest = 0;
+    for (int successor : graph_->successors(index))
+    {
+        longest = std::max(longest, tail_[successor]);
+    }
+    return longest;
+}
+
+template <typename Queue>
+void IncrementalCPM::enqueueAll(ArrayView<int> indices, Queue& pending)
+{
+    for (int index : indices)
+    {
+        if (!queued_[index] && position_[index] >= 0)
+        {
+            queued_[index] = 1;
+            pending.emplace(position_[index], index);
+        }
+    }
+}
+
+CPMResult IncrementalCPM::update(const std::vector<DurationChange>& changes)
+{
+    visitedTasks_ = 0;
+    std::vector<int> changed;
+    changed.reserve(changes.size());
+    for (const DurationChange& change : changes)
+    {
+        const int index = graph_->indexOf(change.taskId);
+        if (index < 0 || position_[index] < 0 || durations_[index] == change.duration)
+        {
+            continue;
+        }
+        durations_[index] = change.duration;
+        changed.push_back(index);
+    }
+
+    if (!changed.empty())
+    {
+        for (int index : changed)
+        {
+            edited_[index] = 1;
+        }
+        propagateForward(changed);
+        propagateBackward(changed);
+        for (int index : changed)
+        {
+            edited_[index] = 0;
+        }
+    }
+
+    CPMResult result;
+    result.totalDuration = totalDuration();
+    result.criticalPath = criticalPath();
+    return result;
+}
+
+void IncrementalCPM::propagateForward(const std::vector<int>& changed)
+{
+    // Min-heap on topological position: a task is settled only after every
+    // affected predecessor, so each task in the downstream cone is visited once.
+    ForwardQueue pending;
+    enqueueAll(ArrayView<int>(changed), pending);
+
+    while (!pending.empty())
+    {
+        const int current = pending.top().second;
+        pending.pop();
+        queued_[current] = 0;
+        ++visitedTasks_;
+
+        int start = 0;
+        for (int predecessor : graph_->predecessors(current))
+        {
+            start = std::max(start, earlyFinish(predecessor));
+        }
+        const bool startChanged = start != earlyStart_[current];
+        earlyStart_[current] = start;
+
+        // Successors only see EF, which moves with ES or with the duration.
+        if (startChanged || edited_[current])
+        {
+            enqueueAll(graph_->successors(current), pending);
+        }
+    }
+}
+
+void IncrementalCPM::propagateBackward(const std::vector<int>& changed)
+{
+    // Max-heap on topological position: the mirror image of propagateForward.
+    BackwardQueue pending;
+    enqueueAll(ArrayView<int>(changed), pending);
+
+    while (!pending.empty())
+    {
+        const int current = pending.top().second;
+        pending.pop();
+        queued_[current] = 0;
+        ++visitedTasks_;
+
+        const int tail = durations_[current] + longestSuccessorTail(current);
+        const bool tailChanged = tail != tail_[current];
+
+        if (tailChanged && graph_->isSource(current))
+        {
+            sourceTails_.erase({-tail_[current], current});
+            sourceTails_.emplace(-tail, current);
+        }
+        tail_[current] = tail;
+
+        if (tailChanged)
+        {
+            enqueueAll(graph_->predecessors(current), pending);
+        }
+    }
+}
+
+int IncrementalCPM::totalDuration() const
+{
+    return sourceTails_.empty() ? 0 : std::max(0, -sourceTails_.begin()->first);
+}
+
+std::vector<int> IncrementalCPM::criticalPath() const
+{
+    std::vector<int> path;
+    if (sourceTails_.empty())
+    {
+        return path;
+    }
+
+    int current = sourceTails_.begin()->second;
+    while (true)
+    {
+        path.push_back(graph_->taskId(current));
+
+        int next = -1;
+        for (int successor : graph_->successors(current))
+        {
+            if (scheduled(successor) && earlyStart_[successor] == earlyFinish(current) && slack(successor) == 0)
+            {
+                next = successor;
+                break;
+            }
+        }
+        if (next < 0)
+        {
+            break;
+        }
+        current = next;
+    }
+    return path;
+}
+
+ProjectSchedule<int> IncrementalCPM::schedule() const
+{
+    ProjectSchedule<int> result;
+    const int taskCount = graph_->size();
+    result.reset(taskCount);
+    for (int i = 0; i < taskCount; ++i)
+    {
+        result.ES[i] = earlyStart(i);
+        result.EF[i] = earlyFinish(i);
+        result.LS[i] = lateStart(i);
+        result.LF[i] = lateFinish(i);
+        result.slack[i] = slack(i);
+    }
+    return result;
+}
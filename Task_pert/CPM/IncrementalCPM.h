@@ -0,0 +1,80 @@
+#ifndef CPM_INCREMENTAL_CPM_H
+#define CPM_INCREMENTAL_CPM_H
+
+#include <functional>
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "CPMCalculator.h"
+#include "ProjectGraph.h"
+
+struct DurationChange
+{
+    int taskId = 0;
+    int duration = 0;
+};
+
+// What-if CPM: keeps the schedule of a compiled project and re-evaluates it
+// after duration edits. ES/EF are repaired only in the downstream cone of the
+// edited tasks and the tail lengths (longest path from a task's start to the
+// project end, i.e. total - LS) only in the upstream cone, each visited once
+// in topological order. LS/LF/slack are derived from the tail and the total on
+// demand, so a change of the project length does not touch every task.
+//
+// Tasks on a dependency cycle (and behind one) are not scheduled: they report
+// the zero times CPMCalculator::analyze leaves them with (a sink's late finish
+// being the total), and their edits are ignored. Unlike analyze, which pins the
+// late finish of their predecessors to 0, the tails here leave them out, so
+// those predecessors keep meaningful late times.
+class IncrementalCPM
+{
+public:
+    explicit IncrementalCPM(const ProjectGraph& graph);
+
+    // Applies the new durations and returns the updated total duration and a
+    // critical path (walked from the longest source along zero-slack edges).
+    CPMResult update(const std::vector<DurationChange>& changes);
+
+    int totalDuration() const;
+    std::vector<int> criticalPath() const;
+
+    // Tasks to schedule (every task in ProjectGraph's topological order)
+    // re-evaluated by the last update, over both passes.
+    int visitedTasks() const { return visitedTasks_; }
+
+    bool scheduled(int index) const { return position_[index] >= 0; }
+    int duration(int index) const { return durations_[index]; }
+    int earlyStart(int index) const { return earlyStart_[index]; }
+    int earlyFinish(int index) const { return scheduled(index) ? earlyStart_[index] + durations_[index] : 0; }
+    int lateStart(int index) const { return scheduled(index) ? totalDuration() - tail_[index] : 0; }
+    int lateFinish(int index) const;
+    int slack(int index) const { return lateStart(index) - earlyStart_[index]; }
+
+    // Full schedule in ProjectGraph indexing (O(N)).
+    ProjectSchedule<int> schedule() const;
+
+private:
+    // (topological position, index); the forward pass pops the earliest task first.
+    using ForwardQueue = std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>>;
+    using BackwardQueue = std::priority_queue<std::pair<int, int>>;
+
+    template <typename Queue>
+    void enqueueAll(ArrayView<int> indices, Queue& pending);
+    int longestSuccessorTail(int index) const; // tasks off the order count as 0
+    void propagateForward(const std::vector<int>& changed);
+    void propagateBackward(const std::vector<int>& changed);
+
+    const ProjectGraph* graph_;
+    std::vector<int> durations_;
+    std::vector<int> position_;   // topological position, -1 on a cycle
+    std::vector<int> earlyStart_;
+    std::vector<int> tail_;       // 0 off the topological order
+    std::vector<char> queued_;    // scratch flags for the propagation queues
+    std::vector<char> edited_;    // tasks whose duration changed in the current update
+    std::set<std::pair<int, int>> sourceTails_; // (-tail, index) of every source
+    int visitedTasks_ = 0;
+};
+
+#endif // CPM_INCREMENTAL_CPM_H
@@ -0,0 +1,124 @@
+#ifndef CPM_LEVEL_SCHEDULER_H
+#define CPM_LEVEL_SCHEDULER_H
+
+#include <algorithm>
+#include <vector>
+
+#include "LongestPath.h"
+#include "ProjectGraph.h"
+#include "ThreadPool.h"
+
+// Level-synchronous (wavefront) CPM passes shared by CPMCalculator and
+// PERTCalculator, built on the per-task steps of LongestPath. The forward pass walks ProjectGraph's levels in order and
+// the backward pass in reverse; inside a level every task only reads values
+// of other levels (ES/EF pulled from predecessors, LS/LF from successors), so
+// the level is split across the pool without locks. Levels narrower than
+// kParallelLevelWidth run inline on the calling thread.
+namespace LevelScheduler
+{
+constexpr int kParallelLevelWidth = 4096;
+constexpr int kGrain = 1024;
+
+// Fills `schedule` (already reset to graph.size()) and returns the project duration.
+template <typename T>
+T computeSchedule(const ProjectGraph& graph,
+                  ArrayView<T> durations,
+                  ProjectSchedule<T>& schedule,
+                  ThreadPool& pool)
+{
+    auto forEachTask = [&pool](ArrayView<int> tasks, const auto& body)
+    {
+        auto range = [&tasks, &body](int begin, int end)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                body(tasks[i]);
+            }
+        };
+        const int count = static_cast<int>(tasks.size());
+        if (count < kParallelLevelWidth)
+        {
+            range(0, count);
+        }
+        else
+        {
+            pool.parallelFor(count, kGrain, range);
+        }
+    };
+
+    // Forward pass.
+    const int* predecessorOffsets = graph.predecessorOffsets().data();
+    const int* predecessors = graph.predecessorIndices().data();
+    for (int level = 0; level < graph.levelCount(); ++level)
+    {
+        forEachTask(graph.level(level),
+                    [&](int current)
+                    {
+                        const T start =
+                            LongestPath::earlyStart(current, predecessorOffsets, predecessors, schedule.EF.data());
+                        schedule.ES[current] = start;
+                        schedule.EF[current] = start + durations[current];
+                    });
+    }
+
+    // Project duration: per-chunk maxima over the sinks, combined in chunk order.
+    const int taskCount = graph.size();
+    const int chunkCount = std::max(1, std::min(taskCount / kGrain, 4 * pool.threadCount()));
+    std::vector<T> chunkMaxima(chunkCount, T{});
+    auto reduceChunks = [&](int begin, int end)
+    {
+        for (int chunk = begin; chunk < end; ++chunk)
+        {
+            const int first = static_cast<int>(static_cast<long long>(taskCount) * chunk / chunkCount);
+            const int last = static_cast<int>(static_cast<long long>(taskCount) * (chunk + 1) / chunkCount);
+            T chunkMax{};
+            for (int i = first; i < last; ++i)
+            {
+                if (graph.isSink(i))
+                {
+                    chunkMax = std::max(chunkMax, schedule.EF[i]);
+                }
+            }
+            chunkMaxima[chunk] = chunkMax;
+        }
+    };
+    pool.parallelFor(chunkCount, 1, reduceChunks);
+
+    T totalDuration{};
+    for (const T& chunkMax : chunkMaxima)
+    {
+        totalDuration = std::max(totalDuration, chunkMax);
+    }
+
+    // Backward pass.
+    const int* successorOffsets = graph.successorOffsets().data();
+    const int* successors = graph.successorIndices().data();
+    for (int level = graph.levelCount() - 1; level >= 0; --level)
+    {
+        forEachTask(graph.level(level),
+                    [&](int current)
+                    {
+                        const T lateFinish = LongestPath::lateFinish(current, successorOffsets, successors,
+                                                                     schedule.LS.data(), totalDuration);
+                        schedule.LF[current] = lateFinish;
+                        schedule.LS[current] = lateFinish - durations[current];
+                        schedule.slack[current] = lateFinish - schedule.EF[current];
+                    });
+    }
+
+    return totalDuration;
+}
+
+// Whether the level structure is wide enough for computeSchedule to beat the
+// sequential Kahn-order passes. Graphs with cycles keep the sequential passes,
+// whose partial results for the unscheduled tasks callers already rely on.
+inline bool worthParallel(const ProjectGraph& graph, const ThreadPool& pool)
+{
+    const int taskCount = graph.size();
+    return pool.threadCount() > 1 && graph.levelCount() > 0 &&
+           static_cast<int>(graph.topologicalOrder().size()) == taskCount &&
+           taskCount / graph.levelCount() >= kParallelLevelWidth;
+}
+}
+
+#endif // CPM_LEVEL_SCHEDULER_H
@@ -0,0 +1,209 @@
+#ifndef CPM_LONGEST_PATH_H
+#define CPM_LONGEST_PATH_H
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "ProjectGraph.h"
+
+// Longest-path (CPM) kernel shared by CPMCalculator (int durations),
+// PERTCalculator (expected durations), LevelScheduler and the Monte Carlo
+// forward pass. Everything is templated on the duration type (int, long long,
+// float, double, ...) and on the Output the caller needs, so each caller gets
+// a pass specialised at compile time: the columns it does not ask for are
+// neither written nor allocated, and no option is tested inside the loops.
+//
+// Both passes pull values over CSR adjacency: a task's early start is the
+// latest early finish among its predecessors, its late finish the earliest
+// late start among its successors. Tasks on a dependency cycle are absent
+// from the topological order and keep the values they had (zero after
+// ProjectSchedule::reset), except that a sink's late finish is the total.
+namespace LongestPath
+{
+enum class Output
+{
+    Total,        // project duration; only EF is written
+    EarlyTimes,   // ES and EF
+    FullSchedule  // ES, EF, LS, LF and slack
+};
+
+// Topological order of the positions 0 .. n - 1 themselves (a graph already
+// flattened in topological order, like MonteCarloEngine's).
+struct Positions
+{
+    int operator[](int position) const { return position; }
+};
+
+// Latest early finish among the predecessors of `task`; 0 for a source.
+template <typename T>
+inline T earlyStart(int task, const int* offsets, const int* predecessors, const T* earlyFinish)
+{
+    T start{};
+    for (int edge = offsets[task]; edge < offsets[task + 1]; ++edge)
+    {
+        start = std::max(start, earlyFinish[predecessors[edge]]);
+    }
+    return start;
+}
+
+// Earliest late start among the successors of `task`; `total` for a sink.
+template <typename T>
+inline T lateFinish(int task, const int* offsets, const int* successors, const T* lateStart, T total)
+{
+    const int firstEdge = offsets[task];
+    const int lastEdge = offsets[task + 1];
+    if (firstEdge == lastEdge)
+    {
+        return total;
+    }
+
+    T finish = lateStart[successors[firstEdge]];
+    for (int edge = firstEdge + 1; edge < lastEdge; ++edge)
+    {
+        finish = std::min(finish, lateStart[successors[edge]]);
+    }
+    return finish;
+}
+
+// Forward pass over the first `count` tasks of `order` (a ProjectGraph's
+// topological order or Positions). `earlyStart` is not touched for Output::Total.
+template <Output Out, typename T, typename Order>
+inline void forwardPass(const Order& order,
+                        int count,
+                        const int* offsets,
+                        const int* predecessors,
+                        const T* durations,
+                        T* earlyStarts,
+                        T* earlyFinishes)
+{
+    for (int k = 0; k < count; ++k)
+    {
+        const int current = order[k];
+        const T start = earlyStart(current, offsets, predecessors, earlyFinishes);
+        if constexpr (Out != Output::Total)
+        {
+            earlyStarts[current] = start;
+        }
+        earlyFinishes[current] = start + durations[current];
+    }
+}
+
+// Latest early finish among `tasks[0 .. count - 1]` (the sinks), 0 when there are none.
+template <typename T>
+inline T completionTime(const T* earlyFinishes, const int* tasks, int count)
+{
+    T completion{};
+    for (int k = 0; k < count; ++k)
+    {
+        completion = std::max(completion, earlyFinishes[tasks[k]]);
+    }
+    return completion;
+}
+
+// Runs the passes `Out` asks for over `graph` and returns the project
+// duration. The schedule columns must already be sized to graph.size() and
+// zeroed (ProjectSchedule::reset); for Output::Total only EF is used.
+template <Output Out, typename T>
+T computeSchedule(const ProjectGraph& graph, ArrayView<T> durations, ProjectSchedule<T>& schedule)
+{
+    const int taskCount = graph.size();
+    const ArrayView<int> topoOrder = graph.topologicalOrder();
+    const int ordered = static_cast<int>(topoOrder.size());
+
+    forwardPass<Out>(topoOrder, ordered, graph.predecessorOffsets().data(), graph.predecessorIndices().data(),
+                     durations.data(), schedule.ES.data(), schedule.EF.data());
+
+    T totalDuration{};
+    for (int i = 0; i < taskCount; ++i)
+    {
+        if (graph.isSink(i))
+        {
+            totalDuration = std::max(totalDuration, schedule.EF[i]);
+        }
+    }
+
+    if constexpr (Out == Output::FullSchedule)
+    {
+        for (int i = 0; i < taskCount; ++i)
+        {
+            if (graph.isSink(i))
+            {
+                schedule.LF[i] = totalDuration;
+            }
+        }
+
+        const int* offsets = graph.successorOffsets().data();
+        const int* successors = graph.successorIndices().data();
+        for (int k = ordered - 1; k >= 0; --k)
+        {
+            const int current = topoOrder[k];
+            const T finish = lateFinish(current, offsets, successors, schedule.LS.data(), totalDuration);
+            schedule.LF[current] = finish;
+            schedule.LS[current] = finish - durations[current];
+            schedule.slack[current] = finish - schedule.EF[current];
+        }
+    }
+
+    return totalDuration;
+}
+
+// Zero slack: exact for integral durations, within 1e-6 for floating-point ones.
+template <typename T>
+inline bool isCritical(T slack)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        return std::abs(slack) < T(1e-6);
+    }
+    else
+    {
+        return slack == 0;
+    }
+}
+
+// Graph indices of a critical path: the zero-slack tasks in ES order, each
+// kept only if it directly succeeds the previously kept one.
+template <typename T>
+std::vector<int> criticalChain(const ProjectGraph& graph, const ProjectSchedule<T>& schedule)
+{
+    const int taskCount = graph.size();
+
+    std::vector<int> criticalCandidates;
+    criticalCandidates.reserve(taskCount);
+    for (int i = 0; i < taskCount; ++i)
+    {
+        if (isCritical(schedule.slack[i]))
+        {
+            criticalCandidates.push_back(i);
+        }
+    }
+
+    std::sort(criticalCandidates.begin(), criticalCandidates.end(),
+              [&schedule](int lhs, int rhs)
+              {
+                  return schedule.ES[lhs] < schedule.ES[rhs];
+              });
+
+    std::vector<int> chain;
+    if (!criticalCandidates.empty())
+    {
+        int previous = criticalCandidates.front();
+        chain.push_back(previous);
+        for (std::size_t idx = 1; idx < criticalCandidates.size(); ++idx)
+        {
+            const int current = criticalCandidates[idx];
+            const ArrayView<int> successors = graph.successors(previous);
+            if (std::find(successors.begin(), successors.end(), current) != successors.end())
+            {
+                chain.push_back(current);
+                previous = current;
+            }
+        }
+    }
+    return chain;
+}
+}
+
+#endif // CPM_LONGEST_PATH_H
@@ -0,0 +1,294 @@
+#include "PathEnumerator.h"
+#include "LongestPath.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+// Node of a persistent leftist min-heap of sidetracks, keyed by their cost.
+template <typename T>
+struct HeapNode
+{
+    T cost{};
+    int from = 0;   // sidetrack from -> to
+    int to = 0;
+    int left = -1;
+    int right = -1;
+    int rank = 1;   // length of the right spine
+};
+
+// A listed path: its last sidetrack (a heap node) and the path it branches off.
+struct PathRecord
+{
+    int node = -1;
+    int parent = -1;
+};
+
+template <typename T>
+class SidetrackHeaps
+{
+public:
+    int rank(int node) const { return node < 0 ? 0 : nodes_[node].rank; }
+    const HeapNode<T>& operator[](int node) const { return nodes_[node]; }
+
+    // Sorted sidetracks as a left-leaning chain, which is already a leftist heap.
+    int chain(const std::vector<HeapNode<T>>& sorted)
+    {
+        int head = -1;
+        for (auto it = sorted.rbegin(); it != sorted.rend(); ++it)
+        {
+            nodes_.push_back(*it);
+            nodes_.back().left = head;
+            head = static_cast<int>(nodes_.size()) - 1;
+        }
+        return head;
+    }
+
+    // Persistent meld: copies only the nodes on the merged right spines.
+    int meld(int a, int b)
+    {
+        if (a < 0)
+        {
+            return b;
+        }
+        if (b < 0)
+        {
+            return a;
+        }
+        if (nodes_[b].cost < nodes_[a].cost)
+        {
+            std::swap(a, b);
+        }
+
+        nodes_.push_back(nodes_[a]);
+        const int copy = static_cast<int>(nodes_.size()) - 1;
+        const int right = meld(nodes_[copy].right, b);
+        HeapNode<T>& node = nodes_[copy];
+        node.right = right;
+        if (rank(node.left) < rank(node.right))
+        {
+            std::swap(node.left, node.right);
+        }
+        node.rank = rank(node.right) + 1;
+        return copy;
+    }
+
+private:
+    std::vector<HeapNode<T>> nodes_;
+};
+
+template <typename T>
+bool withinSlack(T slack, double maxSlack)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        return slack <= maxSlack || LongestPath::isCritical(slack - maxSlack);
+    }
+    else
+    {
+        return slack <= maxSlack;
+    }
+}
+
+template <typename T>
+std::vector<ProjectPath<T>> enumeratePaths(const ProjectGraph& graph, ArrayView<T> durations, const PathQuery& query)
+{
+    std::vector<ProjectPath<T>> paths;
+    const ArrayView<int> topoOrder = graph.topologicalOrder();
+    if (query.maxPaths <= 0 || topoOrder.empty())
+    {
+        return paths;
+    }
+
+    // Task `start` is the virtual task before every source.
+    const int taskCount = graph.size();
+    const int start = taskCount;
+    std::vector<char> ordered(taskCount, 0);
+    for (int index : topoOrder)
+    {
+        ordered[index] = 1;
+    }
+
+    // Successors off the topological order are on a cycle; duplicate edges count once.
+    std::vector<int> sources;
+    for (int index : topoOrder)
+    {
+        if (graph.isSource(index))
+        {
+            sources.push_back(index);
+        }
+    }
+    std::vector<int> candidates;
+    auto nextTasks = [&](int task) -> const std::vector<int>&
+    {
+        if (task == start)
+        {
+            return sources;
+        }
+        candidates.clear();
+        for (int successor : graph.successors(task))
+        {
+            if (ordered[successor])
+            {
+                candidates.push_back(successor);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        return candidates;
+    };
+
+    // Longest tail (own duration plus the longest continuation) and best successor per task.
+    std::vector<T> tail(taskCount + 1, T{});
+    std::vector<int> next(taskCount + 1, -1);
+    auto chooseNext = [&](int task)
+    {
+        for (int candidate : nextTasks(task))
+        {
+            if (next[task] < 0 || tail[candidate] > tail[next[task]])
+            {
+                next[task] = candidate;
+            }
+        }
+        const T duration = task == start ? T{} : durations[task];
+        tail[task] = duration + (next[task] >= 0 ? tail[next[task]] : T{});
+    };
+    for (auto it = topoOrder.end(); it != topoOrder.begin();)
+    {
+        chooseNext(*--it);
+    }
+    chooseNext(start);
+    const T total = tail[start];
+
+    // heap[task]: every sidetrack on the tree path from `task`, built from the
+    // best successor's heap (which the reverse topological order visits first).
+    SidetrackHeaps<T> heaps;
+    std::vector<int> heap(taskCount + 1, -1);
+    std::vector<HeapNode<T>> sidetracks;
+    auto buildHeap = [&](int task)
+    {
+        const T continuation = next[task] >= 0 ? tail[next[task]] : T{};
+        sidetracks.clear();
+        for (int successor : nextTasks(task))
+        {
+            if (successor != next[task])
+            {
+                HeapNode<T> sidetrack;
+                sidetrack.cost = continuation - tail[successor];
+                sidetrack.from = task;
+                sidetrack.to = successor;
+                sidetracks.push_back(sidetrack);
+            }
+        }
+        std::sort(sidetracks.begin(), sidetracks.end(),
+                  [](const HeapNode<T>& lhs, const HeapNode<T>& rhs)
+                  {
+                      return std::tie(lhs.cost, lhs.to) < std::tie(rhs.cost, rhs.to);
+                  });
+        heap[task] = heaps.meld(next[task] >= 0 ? heap[next[task]] : -1, heaps.chain(sidetracks));
+    };
+    for (auto it = topoOrder.end(); it != topoOrder.begin();)
+    {
+        buildHeap(*--it);
+    }
+    buildHeap(start);
+
+    // Best-first search: a record's successors replace its last sidetrack by
+    // a heap child (costlier, same branch point) or append the cheapest
+    // sidetrack after it, so slacks come out in non-decreasing order.
+    std::vector<PathRecord> records;
+    using Entry = std::pair<T, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> pending;
+    auto push = [&](int node, int parent, T slack)
+    {
+        records.push_back({node, parent});
+        pending.emplace(slack, static_cast<int>(records.size()) - 1);
+    };
+
+    std::vector<std::pair<int, int>> route;
+    auto emit = [&](int record)
+    {
+        route.clear();
+        for (int r = record; r >= 0; r = records[r].parent)
+        {
+            route.emplace_back(heaps[records[r].node].from, heaps[records[r].node].to);
+        }
+        std::reverse(route.begin(), route.end());
+
+        ProjectPath<T> path;
+        std::size_t taken = 0;
+        for (int current = start;;)
+        {
+            if (taken < route.size() && route[taken].first == current)
+            {
+                current = route[taken++].second;
+            }
+            else
+            {
+                current = next[current];
+            }
+            if (current < 0)
+            {
+                break;
+            }
+            path.tasks.push_back(graph.taskId(current));
+            path.length += durations[current];
+        }
+        path.slack = total - path.length;
+        paths.push_back(std::move(path));
+    };
+
+    if (withinSlack(T{}, query.maxSlack))
+    {
+        emit(-1);
+    }
+    if (heap[start] >= 0)
+    {
+        push(heap[start], -1, heaps[heap[start]].cost);
+    }
+
+    while (!pending.empty() && static_cast<int>(paths.size()) < query.maxPaths)
+    {
+        const auto [slack, record] = pending.top();
+        pending.pop();
+        if (!withinSlack(slack, query.maxSlack))
+        {
+            break;
+        }
+        emit(record);
+
+        const HeapNode<T> node = heaps[records[record].node];
+        for (int child : {node.left, node.right})
+        {
+            if (child >= 0)
+            {
+                push(child, records[record].parent, slack - node.cost + heaps[child].cost);
+            }
+        }
+        if (heap[node.to] >= 0)
+        {
+            push(heap[node.to], record, slack + heaps[heap[node.to]].cost);
+        }
+    }
+    return paths;
+}
+}
+
+std::vector<ProjectPath<int>> PathEnumerator::longestPaths(const ProjectGraph& graph,
+                                                           ArrayView<int> durations,
+                                                           const PathQuery& query)
+{
+    return enumeratePaths(graph, durations, query);
+}
+
+std::vector<ProjectPath<double>> PathEnumerator::longestPaths(const ProjectGraph& graph,
+                                                              ArrayView<double> durations,
+                                                              const PathQuery& query)
+{
+    return enumeratePaths(graph, durations, query);
+}
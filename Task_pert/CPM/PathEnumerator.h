@@ -0,0 +1,55 @@
+#ifndef CPM_PATH_ENUMERATOR_H
+#define CPM_PATH_ENUMERATOR_H
+
+#include <limits>
+#include <vector>
+
+#include "ProjectGraph.h"
+
+// A source-to-sink chain of tasks.
+template <typename T>
+struct ProjectPath
+{
+    T length{};             // sum of the task durations
+    T slack{};              // longest path length minus length
+    std::vector<int> tasks; // task ids, source first
+};
+
+// Which paths to list, longest first. Every critical path: maxSlack = 0;
+// the K longest: maxPaths = K; near-critical chains: maxSlack = threshold.
+// The number of critical paths can grow exponentially with the project, so
+// maxPaths always bounds the output.
+struct PathQuery
+{
+    int maxPaths = 100;
+    double maxSlack = std::numeric_limits<double>::infinity();
+};
+
+// Longest-paths enumeration over the project DAG (Eppstein's k-shortest-paths
+// construction, with lengths maximised instead of minimised).
+//
+// The longest path from each task to the project end defines a tree of best
+// successors. Every other edge u -> w is a sidetrack that costs
+// tail(u) - duration(u) - tail(w) of length, and every path is the tree path
+// with a sequence of sidetracks, so its slack is the sum of their costs. Each
+// task gets a persistent leftist heap of the sidetracks reachable along its
+// tree path, built from the heap of its best successor in O(log N) new nodes,
+// and a best-first search over those heaps yields the paths in order of
+// increasing slack in O(log K) each. Preprocessing is O(N log N + M log M)
+// and listing K paths costs O(K log K) plus their lengths, so near-critical
+// chains of large projects come out without exploring the exponential path
+// space. Multiple sources are handled by a virtual start task; tasks on a
+// dependency cycle are ignored and parallel duplicate edges count once.
+class PathEnumerator
+{
+public:
+    static std::vector<ProjectPath<int>> longestPaths(const ProjectGraph& graph,
+                                                      ArrayView<int> durations,
+                                                      const PathQuery& query);
+
+    static std::vector<ProjectPath<double>> longestPaths(const ProjectGraph& graph,
+                                                         ArrayView<double> durations,
+                                                         const PathQuery& query);
+};
+
+#endif // CPM_PATH_ENUMERATOR_H
@@ -0,0 +1,209 @@
+#include "ProjectGraph.h"
+
+#include <algorithm>
+
+namespace
+{
+int lookupIndex(ArrayView<int> taskIds, int taskId)
+{
+    const auto it = std::lower_bound(taskIds.begin(), taskIds.end(), taskId);
+    if (it == taskIds.end() || *it != taskId)
+    {
+        return -1;
+    }
+    return static_cast<int>(it - taskIds.begin());
+}
+}
+
+template <typename TaskType>
+void ProjectGraph::compileTopology(const std::map<int, TaskType>& tasks)
+{
+    const int taskCount = static_cast<int>(tasks.size());
+
+    std::vector<int> taskIds;
+    taskIds.reserve(taskCount);
+    for (const auto& [id, task] : tasks)
+    {
+        taskIds.push_back(id);
+    }
+
+    // CSR arrays keep the per-task edge order of the source map.
+    std::vector<int> successorOffsets(taskCount + 1, 0);
+    std::vector<int> predecessorOffsets(taskCount + 1, 0);
+    std::vector<int> successorIndices;
+    std::vector<int> predecessorIndices;
+
+    int index = 0;
+    for (const auto& [id, task] : tasks)
+    {
+        for (int successorId : task.successors)
+        {
+            const int successorIndex = lookupIndex(taskIds, successorId);
+            if (successorIndex >= 0)
+            {
+                successorIndices.push_back(successorIndex);
+            }
+        }
+        for (int predecessorId : task.predecessors)
+        {
+            const int predecessorIndex = lookupIndex(taskIds, predecessorId);
+            if (predecessorIndex >= 0)
+            {
+                predecessorIndices.push_back(predecessorIndex);
+            }
+        }
+        ++index;
+        successorOffsets[index] = static_cast<int>(successorIndices.size());
+        predecessorOffsets[index] = static_cast<int>(predecessorIndices.size());
+    }
+
+    taskIds_ = GraphColumn<int>(std::move(taskIds));
+    successorOffsets_ = GraphColumn<int>(std::move(successorOffsets));
+    successorIndices_ = GraphColumn<int>(std::move(successorIndices));
+    predecessorOffsets_ = GraphColumn<int>(std::move(predecessorOffsets));
+    predecessorIndices_ = GraphColumn<int>(std::move(predecessorIndices));
+
+    // Kahn's algorithm, seeded with the sources in index order.
+    std::vector<int> inDegree(taskCount, 0);
+    std::vector<int> topologicalOrder;
+    topologicalOrder.reserve(taskCount);
+    for (int i = 0; i < taskCount; ++i)
+    {
+        inDegree[i] = predecessorOffsets_[i + 1] - predecessorOffsets_[i];
+        if (inDegree[i] == 0)
+        {
+            topologicalOrder.push_back(i);
+        }
+    }
+
+    std::vector<int> levels(taskCount, 0);
+    int levelCount = topologicalOrder.empty() ? 0 : 1;
+    std::size_t head = 0;
+    while (head < topologicalOrder.size())
+    {
+        const int current = topologicalOrder[head++];
+        for (int successor : successors(current))
+        {
+            levels[successor] = std::max(levels[successor], levels[current] + 1);
+            if (--inDegree[successor] == 0)
+            {
+                topologicalOrder.push_back(successor);
+                levelCount = std::max(levelCount, levels[successor] + 1);
+            }
+        }
+    }
+
+    // Counting sort of the scheduled tasks by level.
+    std::vector<int> levelOffsets(levelCount + 1, 0);
+    for (int current : topologicalOrder)
+    {
+        ++levelOffsets[levels[current] + 1];
+    }
+    for (int level = 0; level < levelCount; ++level)
+    {
+        levelOffsets[level + 1] += levelOffsets[level];
+    }
+    std::vector<int> levelOrder(topologicalOrder.size(), 0);
+    std::vector<int> cursor(levelOffsets.begin(), levelOffsets.end() - 1);
+    for (int position = 0; position < taskCount; ++position)
+    {
+        if (inDegree[position] == 0)
+        {
+            levelOrder[cursor[levels[position]]++] = position;
+        }
+    }
+
+    topologicalOrder_ = GraphColumn<int>(std::move(topologicalOrder));
+    levelOffsets_ = GraphColumn<int>(std::move(levelOffsets));
+    levelOrder_ = GraphColumn<int>(std::move(levelOrder));
+}
+
+ProjectGraph ProjectGraph::compile(const std::map<int, Task>& tasks)
+{
+    ProjectGraph graph;
+    graph.compileTopology(tasks);
+
+    std::vector<int> durations;
+    durations.reserve(tasks.size());
+    for (const auto& [id, task] : tasks)
+    {
+        durations.push_back(task.duration);
+    }
+    graph.durations_ = GraphColumn<int>(std::move(durations));
+    return graph;
+}
+
+ProjectGraph ProjectGraph::compile(const std::map<int, Task_pert>& tasks)
+{
+    ProjectGraph graph;
+    graph.compileTopology(tasks);
+
+    std::vector<int> optimisticTimes;
+    std::vector<int> mostLikelyTimes;
+    std::vector<int> pessimisticTimes;
+    std::vector<double> expectedDurations;
+    std::vector<double> variances;
+    optimisticTimes.reserve(tasks.size());
+    mostLikelyTimes.reserve(tasks.size());
+    pessimisticTimes.reserve(tasks.size());
+    expectedDurations.reserve(tasks.size());
+    variances.reserve(tasks.size());
+    for (const auto& [id, task] : tasks)
+    {
+        optimisticTimes.push_back(task.optimistic_time);
+        mostLikelyTimes.push_back(task.most_likely_time);
+        pessimisticTimes.push_back(task.pessimistic_time);
+        expectedDurations.push_back(task.expected_duration);
+        variances.push_back(task.variance);
+    }
+    graph.optimisticTimes_ = GraphColumn<int>(std::move(optimisticTimes));
+    graph.mostLikelyTimes_ = GraphColumn<int>(std::move(mostLikelyTimes));
+    graph.pessimisticTimes_ = GraphColumn<int>(std::move(pessimisticTimes));
+    graph.expectedDurations_ = GraphColumn<double>(std::move(expectedDurations));
+    graph.variances_ = GraphColumn<double>(std::move(variances));
+    return graph;
+}
+
+ProjectGraph::Columns ProjectGraph::columns() const
+{
+    return {taskIds_.view(),
+            successorOffsets_.view(),
+            successorIndices_.view(),
+            predecessorOffsets_.view(),
+            predecessorIndices_.view(),
+            topologicalOrder_.view(),
+            levelOffsets_.view(),
+            levelOrder_.view(),
+            durations_.view(),
+            optimisticTimes_.view(),
+            mostLikelyTimes_.view(),
+            pessimisticTimes_.view(),
+            expectedDurations_.view(),
+            variances_.view()};
+}
+
+ProjectGraph ProjectGraph::attach(const Columns& columns, std::shared_ptr<const void> storage)
+{
+    ProjectGraph graph;
+    graph.taskIds_ = GraphColumn<int>(columns.taskIds);
+    graph.successorOffsets_ = GraphColumn<int>(columns.successorOffsets);
+    graph.successorIndices_ = GraphColumn<int>(columns.successorIndices);
+    graph.predecessorOffsets_ = GraphColumn<int>(columns.predecessorOffsets);
+    graph.predecessorIndices_ = GraphColumn<int>(columns.predecessorIndices);
+    graph.topologicalOrder_ = GraphColumn<int>(columns.topologicalOrder);
+    graph.levelOffsets_ = GraphColumn<int>(columns.levelOffsets);
+    graph.levelOrder_ = GraphColumn<int>(columns.levelOrder);
+    graph.durations_ = GraphColumn<int>(columns.durations);
+    graph.optimisticTimes_ = GraphColumn<int>(columns.optimisticTimes);
+    graph.mostLikelyTimes_ = GraphColumn<int>(columns.mostLikelyTimes);
+    graph.pessimisticTimes_ = GraphColumn<int>(columns.pessimisticTimes);
+    graph.expectedDurations_ = GraphColumn<double>(columns.expectedDurations);
+    graph.variances_ = GraphColumn<double>(columns.variances);
+    graph.storage_ = std::move(storage);
+    return graph;
+}
+
+int ProjectGraph::indexOf(int taskId) const
+{
+    return lookupIndex(taskIds_.view(), taskId);
+}
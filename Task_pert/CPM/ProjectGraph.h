@@ -0,0 +1,223 @@
+#ifndef CPM_PROJECT_GRAPH_H
+#define CPM_PROJECT_GRAPH_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Task.h"
+#include "Task_pert.h"
+
+// Read-only window over a contiguous column of the compiled graph.
+template <typename T>
+class ArrayView
+{
+public:
+    ArrayView() = default;
+
+    ArrayView(const T* data, std::size_t size)
+        : data_(data), size_(size)
+    {
+    }
+
+    ArrayView(const std::vector<T>& values)
+        : data_(values.data()), size_(values.size())
+    {
+    }
+
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T& operator[](std::size_t index) const { return data_[index]; }
+
+private:
+    const T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Column of the compiled graph: either owns its values or views memory owned
+// elsewhere (a mapped ProjectSnapshot). Accessors always read through the view.
+template <typename T>
+class GraphColumn
+{
+public:
+    GraphColumn() = default;
+
+    explicit GraphColumn(std::vector<T> values)
+        : values_(std::move(values)), view_(values_)
+    {
+    }
+
+    explicit GraphColumn(ArrayView<T> external)
+        : view_(external), external_(true)
+    {
+    }
+
+    GraphColumn(const GraphColumn& other)
+        : values_(other.values_), view_(other.external_ ? other.view_ : ArrayView<T>(values_)),
+          external_(other.external_)
+    {
+    }
+
+    GraphColumn(GraphColumn&& other) noexcept
+        : values_(std::move(other.values_)), view_(other.view_), external_(other.external_)
+    {
+        other.view_ = ArrayView<T>();
+    }
+
+    GraphColumn& operator=(GraphColumn other) noexcept
+    {
+        values_.swap(other.values_);
+        std::swap(view_, other.view_);
+        std::swap(external_, other.external_);
+        return *this;
+    }
+
+    ArrayView<T> view() const { return view_; }
+    const T* data() const { return view_.data(); }
+    std::size_t size() const { return view_.size(); }
+    bool empty() const { return view_.empty(); }
+    const T& operator[](std::size_t index) const { return view_[index]; }
+
+private:
+    std::vector<T> values_;
+    ArrayView<T> view_;
+    bool external_ = false;
+};
+
+// Project network compiled into dense indices 0..N-1 (ascending task id order)
+// with CSR successor/predecessor arrays and per-task duration columns.
+class ProjectGraph
+{
+public:
+    ProjectGraph() = default;
+
+    static ProjectGraph compile(const std::map<int, Task>& tasks);
+    static ProjectGraph compile(const std::map<int, Task_pert>& tasks);
+
+    // Every column of a compiled graph, e.g. as stored in a ProjectSnapshot.
+    struct Columns
+    {
+        ArrayView<int> taskIds;
+        ArrayView<int> successorOffsets;
+        ArrayView<int> successorIndices;
+        ArrayView<int> predecessorOffsets;
+        ArrayView<int> predecessorIndices;
+        ArrayView<int> topologicalOrder;
+        ArrayView<int> levelOffsets;
+        ArrayView<int> levelOrder;
+        ArrayView<int> durations;
+        ArrayView<int> optimisticTimes;
+        ArrayView<int> mostLikelyTimes;
+        ArrayView<int> pessimisticTimes;
+        ArrayView<double> expectedDurations;
+        ArrayView<double> variances;
+    };
+
+    Columns columns() const;
+
+    // Graph over columns that live in `storage`, which the graph (and its
+    // copies) keep alive. Nothing is copied or recomputed, so the columns must
+    // be those of a compiled graph.
+    static ProjectGraph attach(const Columns& columns, std::shared_ptr<const void> storage);
+
+    int size() const { return static_cast<int>(taskIds_.size()); }
+    int edgeCount() const { return static_cast<int>(successorIndices_.size()); }
+    bool empty() const { return taskIds_.empty(); }
+
+    int taskId(int index) const { return taskIds_[index]; }
+    int indexOf(int taskId) const; // -1 when the id is unknown
+
+    ArrayView<int> successors(int index) const
+    {
+        return {successorIndices_.data() + successorOffsets_[index],
+                static_cast<std::size_t>(successorOffsets_[index + 1] - successorOffsets_[index])};
+    }
+
+    ArrayView<int> predecessors(int index) const
+    {
+        return {predecessorIndices_.data() + predecessorOffsets_[index],
+                static_cast<std::size_t>(predecessorOffsets_[index + 1] - predecessorOffsets_[index])};
+    }
+
+    bool isSource(int index) const { return predecessorOffsets_[index] == predecessorOffsets_[index + 1]; }
+    bool isSink(int index) const { return successorOffsets_[index] == successorOffsets_[index + 1]; }
+
+    // Kahn order (sources in index order first); tasks on a cycle are absent.
+    ArrayView<int> topologicalOrder() const { return topologicalOrder_.view(); }
+
+    // Topological levels: level 0 holds the sources, level k the tasks whose
+    // longest chain of predecessors has k tasks. A task depends only on tasks
+    // of lower levels, so every level can be scheduled in parallel.
+    int levelCount() const { return static_cast<int>(levelOffsets_.size()) - 1; }
+    ArrayView<int> level(int levelIndex) const
+    {
+        return {levelOrder_.data() + levelOffsets_[levelIndex],
+                static_cast<std::size_t>(levelOffsets_[levelIndex + 1] - levelOffsets_[levelIndex])};
+    }
+
+    ArrayView<int> taskIds() const { return taskIds_.view(); }
+    ArrayView<int> successorOffsets() const { return successorOffsets_.view(); }
+    ArrayView<int> successorIndices() const { return successorIndices_.view(); }
+    ArrayView<int> predecessorOffsets() const { return predecessorOffsets_.view(); }
+    ArrayView<int> predecessorIndices() const { return predecessorIndices_.view(); }
+
+    // CPM columns (filled when compiled from Task).
+    ArrayView<int> durations() const { return durations_.view(); }
+
+    // PERT columns (filled when compiled from Task_pert).
+    ArrayView<int> optimisticTimes() const { return optimisticTimes_.view(); }
+    ArrayView<int> mostLikelyTimes() const { return mostLikelyTimes_.view(); }
+    ArrayView<int> pessimisticTimes() const { return pessimisticTimes_.view(); }
+    ArrayView<double> expectedDurations() const { return expectedDurations_.view(); }
+    ArrayView<double> variances() const { return variances_.view(); }
+
+private:
+    template <typename TaskType>
+    void compileTopology(const std::map<int, TaskType>& tasks);
+
+    GraphColumn<int> taskIds_;
+    GraphColumn<int> successorOffsets_;
+    GraphColumn<int> successorIndices_;
+    GraphColumn<int> predecessorOffsets_;
+    GraphColumn<int> predecessorIndices_;
+    GraphColumn<int> topologicalOrder_;
+    GraphColumn<int> levelOffsets_{std::vector<int>{0}};
+    GraphColumn<int> levelOrder_;        // tasks grouped by level, index order within a level
+
+    GraphColumn<int> durations_;
+
+    GraphColumn<int> optimisticTimes_;
+    GraphColumn<int> mostLikelyTimes_;
+    GraphColumn<int> pessimisticTimes_;
+    GraphColumn<double> expectedDurations_;
+    GraphColumn<double> variances_;
+
+    std::shared_ptr<const void> storage_; // owner of the external columns, if any
+};
+
+// Structure-of-arrays schedule produced by the calculators, indexed like ProjectGraph.
+template <typename T>
+struct ProjectSchedule
+{
+    std::vector<T> ES; // Early Start
+    std::vector<T> EF; // Early Finish
+    std::vector<T> LS; // Late Start
+    std::vector<T> LF; // Late Finish
+    std::vector<T> slack;
+
+    void reset(int taskCount)
+    {
+        ES.assign(taskCount, T{});
+        EF.assign(taskCount, T{});
+        LS.assign(taskCount, T{});
+        LF.assign(taskCount, T{});
+        slack.assign(taskCount, T{});
+    }
+};
+
+#endif // CPM_PROJECT_GRAPH_H
@@ -0,0 +1,122 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount)
+{
+    int threads = threadCount > 0 ? threadCount : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, threads);
+
+    shares_.reset(new Share[threads]);
+    workers_.reserve(threads - 1);
+    for (int t = 1; t < threads; ++t)
+    {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, t);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(const std::function<void(int)>& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        pending_ = static_cast<int>(workers_.size());
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    job(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPool::workerLoop(int threadIndex)
+{
+    std::uint64_t seenGeneration = 0;
+    while (true)
+    {
+        const std::function<void(int)>* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seenGeneration; });
+            if (stopping_)
+            {
+                return;
+            }
+            seenGeneration = generation_;
+            job = job_;
+        }
+
+        (*job)(threadIndex);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0)
+        {
+            done_.notify_one();
+        }
+    }
+}
+
+bool ThreadPool::takeChunk(int threadIndex, int grain, int& begin, int& end)
+{
+    std::atomic<std::uint64_t>& bounds = shares_[threadIndex].bounds;
+    std::uint64_t current = bounds.load();
+    while (true)
+    {
+        const int first = static_cast<int>(current >> 32);
+        const int last = static_cast<int>(current & 0xFFFFFFFFu);
+        if (first >= last)
+        {
+            return false;
+        }
+        const int next = std::min(last, first + grain);
+        if (bounds.compare_exchange_weak(current, pack(next, last)))
+        {
+            begin = first;
+            end = next;
+            return true;
+        }
+    }
+}
+
+bool ThreadPool::steal(int threadIndex, int grain)
+{
+    const int threads = threadCount();
+    for (int offset = 1; offset < threads; ++offset)
+    {
+        std::atomic<std::uint64_t>& victim = shares_[(threadIndex + offset) % threads].bounds;
+        std::uint64_t current = victim.load();
+        while (true)
+        {
+            const int first = static_cast<int>(current >> 32);
+            const int last = static_cast<int>(current & 0xFFFFFFFFu);
+            if (last - first <= grain)
+            {
+                break; // the owner finishes small remainders itself
+            }
+            const int middle = first + (last - first) / 2;
+            if (victim.compare_exchange_weak(current, pack(first, middle)))
+            {
+                // Our own share is empty, so nobody else competes for it.
+                shares_[threadIndex].bounds.store(pack(middle, last));
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,101 @@
+#ifndef CPM_THREAD_POOL_H
+#define CPM_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops; the calling thread
+// takes part as thread 0. parallelFor gives every thread one contiguous share
+// of the index range; a thread consumes its share front to back in `grain`
+// sized chunks and, once it is empty, steals the back half of another
+// thread's remainder, so uneven per-index costs still balance out.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(int threadCount = 0); // 0 = one thread per hardware core
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int threadCount() const { return static_cast<int>(workers_.size()) + 1; }
+
+    // Calls body(begin, end) on disjoint ranges covering [0, count) and returns
+    // when all of them are done. Small counts run inline on the caller.
+    template <typename Body>
+    void parallelFor(int count, int grain, const Body& body);
+
+private:
+    struct alignas(64) Share
+    {
+        std::atomic<std::uint64_t> bounds{0}; // begin in the high, end in the low 32 bits
+    };
+
+    static std::uint64_t pack(int begin, int end)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(begin)) << 32) | static_cast<std::uint32_t>(end);
+    }
+
+    void run(const std::function<void(int)>& job);
+    void workerLoop(int threadIndex);
+    bool takeChunk(int threadIndex, int grain, int& begin, int& end);
+    bool steal(int threadIndex, int grain);
+
+    std::vector<std::thread> workers_;
+    std::unique_ptr<Share[]> shares_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(int)>* job_ = nullptr;
+    std::uint64_t generation_ = 0;
+    int pending_ = 0;
+    bool stopping_ = false;
+};
+
+template <typename Body>
+void ThreadPool::parallelFor(int count, int grain, const Body& body)
+{
+    grain = grain > 0 ? grain : 1;
+    const int threads = threadCount();
+    if (threads == 1 || count <= grain)
+    {
+        if (count > 0)
+        {
+            body(0, count);
+        }
+        return;
+    }
+
+    for (int t = 0; t < threads; ++t)
+    {
+        const int begin = static_cast<int>(static_cast<std::int64_t>(count) * t / threads);
+        const int end = static_cast<int>(static_cast<std::int64_t>(count) * (t + 1) / threads);
+        shares_[t].bounds.store(pack(begin, end));
+    }
+
+    run([&](int self)
+        {
+            int begin = 0;
+            int end = 0;
+            while (true)
+            {
+                if (takeChunk(self, grain, begin, end))
+                {
+                    body(begin, end);
+                }
+                else if (!steal(self, grain))
+                {
+                    break;
+                }
+            }
+        });
+}
+
+#endif // CPM_THREAD_POOL_H
@@ -1,6 +1,7 @@
 #ifndef DATALOADER_H
 #define DATALOADER_H
 
+#include "EdgeListParser.h"
 #include "Task.h"
 
 #include <map>
@@ -20,5 +21,6 @@ class DataLoader
 {
 public:
 	static ProjectData read_data(const std::string& filename);
+	static ProjectData read_data(const std::string& filename, const LoadOptions& options);
 };
 #endif // !DATALOADER_H
@@ -1,76 +1,51 @@
 #include "DataLoader_pert.h"
+#include "EdgeListParser.h"
+#include "InputBuffer.h"
+#include "TextScanner.h"
+#include "ThreadPool.h"
 
-#include <iostream>
-#include <fstream>
-#include <sstream>
 #include <algorithm>
+#include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
-namespace
-{
-void strip_bom(std::string& line)
-{
-    if (line.size() >= 3 && static_cast<unsigned char>(line[0]) == 0xEF &&
-        static_cast<unsigned char>(line[1]) == 0xBB &&
-        static_cast<unsigned char>(line[2]) == 0xBF)
-    {
-        line.erase(0, 3);
-    }
-}
-
-std::string trim(const std::string& value)
-{
-    const auto first = value.find_first_not_of(" \t\n\r");
-    if (first == std::string::npos)
-    {
-        return {};
-    }
-    const auto last = value.find_last_not_of(" \t\n\r");
-    return value.substr(first, last - first + 1);
-}
-
-bool is_metadata_line(const std::string& line)
+ProjectDataPert DataLoader_pert::read_data(const std::string& filename)
 {
-    return line.find("in:") != std::string::npos ||
-           line.find("out:") != std::string::npos ||
-           line.find("process time:") != std::string::npos ||
-           line.find("earlyStart") != std::string::npos ||
-           line.find("critical path:") != std::string::npos;
-}
+	return read_data(filename, LoadOptions());
 }
 
-ProjectDataPert DataLoader_pert::read_data(const std::string& filename)
+ProjectDataPert DataLoader_pert::read_data(const std::string& filename, const LoadOptions& options)
 {
 	ProjectDataPert data;
 
-    std::ifstream file(filename);
-    if (!file.is_open()) 
+    const InputBuffer input(filename);
+    if (!input.isOpen()) 
     {
         std::cerr << "Error: Cannot open file " << filename << std::endl;
         data.success = false;
         return data;
     }
 
-    std::string line;
+    LineScanner lines(input.text());
+    std::string_view line;
     int data_line_index = 0;
+    std::vector<Task_pert*> tasks_by_id;
 
-    while (std::getline(file, line))
+    while (lines.next(line))
     {
-        strip_bom(line);
-        line = trim(line);
-
-        if (line.empty() || is_metadata_line(line))
+        if (line.empty() || isMetadataLine(line))
         {
             continue;
         }
 
         data_line_index++;
-        std::stringstream ss(line);
+        NumberScanner ss(line);
 
         if (data_line_index == 1)
         {
             // Linia 1: N i M
-            if (!(ss >> data.N >> data.M)) 
+            if (!ss.read(data.N, data.M)) 
             {
                 std::cerr << "Error reading N and M from file." << std::endl;
                 data.success = false;
@@ -79,35 +54,47 @@ ProjectDataPert DataLoader_pert::read_data(const std::string& filename)
         }
         else if (data_line_index == 2) // optimistic, most likely, pessimistic times
         {
+            // Ids are 1-based. The table grows with the times actually read and is
+            // reserved for at most what the line can hold ("a m b " per task), so a
+            // bogus N in the header cannot allocate more than the file backs.
             int opt, likely, pess;
+            const std::size_t declared = data.N > 0 ? static_cast<std::size_t>(data.N) : 0;
+            tasks_by_id.assign(1, nullptr);
+            tasks_by_id.reserve(std::min(declared, line.size() / 6 + 1) + 1);
             for (int i = 1; i <= data.N; ++i)
             {
-                if (!(ss >> opt >> likely >> pess))
+                if (!ss.read(opt, likely, pess))
                 {
                     std::cerr << "Error reading task times." << std::endl;
                     data.success = false;
                     return data;
                 }
-                data.tasks.emplace(i, Task_pert(i, opt, likely, pess));
+                tasks_by_id.push_back(&data.tasks.emplace_hint(data.tasks.end(), i, Task_pert(i, opt, likely, pess))->second);
             }
         }
         else if (data_line_index == 3)
         {
-            // third line: dependencies
-            int predID, succID;
-            while (ss >> predID >> succID)
-            {
-                if (data.tasks.count(predID) && data.tasks.count(succID))
-                {
-                    data.tasks.at(predID).successors.push_back(succID);
-                    data.tasks.at(succID).predecessors.push_back(predID);
-                }
-            }
+            // third line: dependencies, parsed in parallel into CSR
+            const int task_count = tasks_by_id.empty() ? 0 : static_cast<int>(tasks_by_id.size()) - 1;
+            ThreadPool pool(line.size() >= EdgeListParser::kParallelThreshold ? options.threadCount : 1);
+            const EdgeList edges = EdgeListParser::parse(line, task_count, options.removeDuplicateEdges, pool);
+            pool.parallelFor(task_count, 4096,
+                             [&](int begin, int end)
+                             {
+                                 for (int i = begin; i < end; ++i)
+                                 {
+                                     Task_pert& task = *tasks_by_id[i + 1];
+                                     task.successors.assign(edges.successors.begin() + edges.successorOffsets[i],
+                                                            edges.successors.begin() + edges.successorOffsets[i + 1]);
+                                     task.predecessors.assign(edges.predecessors.begin() + edges.predecessorOffsets[i],
+                                                              edges.predecessors.begin() + edges.predecessorOffsets[i + 1]);
+                                 }
+                             });
         }
         else if (data_line_index == 4)
         {
             // target time and target probability
-            if (!(ss >> data.target_time >> data.target_probability))
+            if (!ss.read(data.target_time, data.target_probability))
             {
                 std::cerr << "Error reading target time and probability." << std::endl;
                 data.success = false;
@@ -1,6 +1,7 @@
 #ifndef DATALOADER_PERT_H
 #define DATALOADER_PERT_H
 
+#include "EdgeListParser.h"
 #include "Task_pert.h"
 
 #include <map>
@@ -21,5 +22,6 @@ class DataLoader_pert
 {
 public:
 	static ProjectDataPert read_data(const std::string& filename);
+	static ProjectDataPert read_data(const std::string& filename, const LoadOptions& options);
 };
 #endif // !DATALOADER_PERT_H
@@ -0,0 +1,337 @@
+#include "EdgeListParser.h"
+#include "TextScanner.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+constexpr int kTaskGrain = 16384;
+constexpr int kRangesPerThread = 4;     // task ranges per thread, so work stealing can even out dense rows
+constexpr int kDuplicateScanLimit = 16; // rows up to this length are deduplicated by a linear scan
+
+// Which id of a (pred, succ) pair a CSR side is keyed by.
+enum Side
+{
+    Successors = 0,   // rows of pred, holding succ
+    Predecessors = 1, // rows of succ, holding pred
+};
+
+// Task indices 0..N-1 cut into `count` ranges of `width` consecutive tasks.
+struct TaskRanges
+{
+    TaskRanges(int taskCount, int wanted)
+        : tasks(taskCount)
+    {
+        wanted = std::max(1, std::min(wanted, taskCount));
+        width = std::max(1, (taskCount + wanted - 1) / wanted);
+        count = std::max(1, (taskCount + width - 1) / width);
+    }
+
+    int of(int index) const { return index / width; }
+    int begin(int range) const { return range * width; }
+    int end(int range) const { return std::min(tasks, (range + 1) * width); }
+
+    int tasks = 0;
+    int width = 1;
+    int count = 1;
+};
+
+// (pred, succ) pairs grouped by the task range of their key id, in input order
+// within every range: range r holds pairs offsets[r] .. offsets[r + 1].
+struct Buckets
+{
+    std::vector<int> pairs;
+    std::vector<int> offsets;
+};
+
+struct Chunk
+{
+    std::string_view text;
+    std::vector<int> tokens;
+    bool malformed = false;     // scanning stopped at a token that is not a number
+    std::size_t firstToken = 0; // index of tokens[0] in the whole line
+    Buckets buckets[2];         // kept pairs that start in this chunk, per Side
+};
+
+// Cuts `text` into `chunkCount` pieces of similar size that begin and end at whitespace.
+std::vector<Chunk> splitAtWhitespace(std::string_view text, int chunkCount)
+{
+    std::vector<Chunk> chunks(chunkCount);
+    std::size_t begin = 0;
+    for (int c = 0; c < chunkCount; ++c)
+    {
+        std::size_t end = c + 1 == chunkCount ? text.size() : std::max(begin, text.size() / chunkCount * (c + 1));
+        while (end < text.size() && !LineScanner::isSpace(text[end]))
+        {
+            ++end;
+        }
+        chunks[c].text = text.substr(begin, end - begin);
+        begin = end;
+    }
+    return chunks;
+}
+
+// Stable counting sort of the (pred, succ) `pairs` by the range of their `side` id.
+void bucketPairs(const std::vector<int>& pairs, Side side, const TaskRanges& ranges, Buckets& buckets)
+{
+    buckets.offsets.assign(ranges.count + 1, 0);
+    for (std::size_t i = side; i < pairs.size(); i += 2)
+    {
+        ++buckets.offsets[ranges.of(pairs[i] - 1) + 1];
+    }
+    for (int range = 0; range < ranges.count; ++range)
+    {
+        buckets.offsets[range + 1] += buckets.offsets[range];
+    }
+
+    std::vector<int> cursor(buckets.offsets.begin(), buckets.offsets.end() - 1);
+    buckets.pairs.resize(pairs.size());
+    for (std::size_t i = 0; i < pairs.size(); i += 2)
+    {
+        const std::size_t slot = 2 * static_cast<std::size_t>(cursor[ranges.of(pairs[i + side] - 1)]++);
+        buckets.pairs[slot] = pairs[i];
+        buckets.pairs[slot + 1] = pairs[i + 1];
+    }
+}
+
+// CSR rows of the tasks in `range` on one side, whose first slot is `base`:
+// counts from the range's buckets, offsets, then the scatter in chunk order.
+// Touches only the range's entries of `offsets` and `cursor` (per task).
+void buildRows(const std::vector<Chunk>& chunks,
+               int usableChunks,
+               const TaskRanges& ranges,
+               int range,
+               Side side,
+               int base,
+               std::vector<int>& offsets,
+               std::vector<int>& values,
+               int* cursor)
+{
+    const int first = ranges.begin(range);
+    const int last = ranges.end(range);
+    std::fill(cursor + first, cursor + last, 0);
+    for (int c = 0; c < usableChunks; ++c)
+    {
+        const Buckets& buckets = chunks[c].buckets[side];
+        for (int k = buckets.offsets[range]; k < buckets.offsets[range + 1]; ++k)
+        {
+            ++cursor[buckets.pairs[2 * static_cast<std::size_t>(k) + side] - 1];
+        }
+    }
+
+    int slot = base;
+    for (int task = first; task < last; ++task)
+    {
+        const int count = cursor[task];
+        cursor[task] = slot;
+        slot += count;
+        offsets[task + 1] = slot;
+    }
+
+    for (int c = 0; c < usableChunks; ++c)
+    {
+        const Buckets& buckets = chunks[c].buckets[side];
+        for (int k = buckets.offsets[range]; k < buckets.offsets[range + 1]; ++k)
+        {
+            const std::size_t pair = 2 * static_cast<std::size_t>(k);
+            values[cursor[buckets.pairs[pair + side] - 1]++] = buckets.pairs[pair + 1 - side];
+        }
+    }
+}
+
+// Drops repeated values from `row` in place, keeping first occurrences in
+// order; returns the new length.
+int removeRepeats(int* row, int length)
+{
+    if (length <= kDuplicateScanLimit)
+    {
+        int kept = 0;
+        for (int i = 0; i < length; ++i)
+        {
+            if (std::find(row, row + kept, row[i]) == row + kept)
+            {
+                row[kept++] = row[i];
+            }
+        }
+        return kept;
+    }
+
+    std::vector<std::pair<int, int>> byValue(length); // (value, position)
+    for (int i = 0; i < length; ++i)
+    {
+        byValue[i] = {row[i], i};
+    }
+    std::sort(byValue.begin(), byValue.end());
+
+    std::vector<char> first(length, 0);
+    for (int i = 0; i < length; ++i)
+    {
+        first[byValue[i].second] = i == 0 || byValue[i].first != byValue[i - 1].first;
+    }
+
+    int kept = 0;
+    for (int i = 0; i < length; ++i)
+    {
+        if (first[i])
+        {
+            row[kept++] = row[i];
+        }
+    }
+    return kept;
+}
+
+void removeRepeatedEntries(std::vector<int>& offsets, std::vector<int>& values, ThreadPool& pool)
+{
+    const int rows = static_cast<int>(offsets.size()) - 1;
+    std::vector<int> compactOffsets(rows + 1, 0);
+    pool.parallelFor(rows, kTaskGrain,
+                     [&](int begin, int end)
+                     {
+                         for (int r = begin; r < end; ++r)
+                         {
+                             compactOffsets[r + 1] = removeRepeats(values.data() + offsets[r], offsets[r + 1] - offsets[r]);
+                         }
+                     });
+    for (int r = 0; r < rows; ++r)
+    {
+        compactOffsets[r + 1] += compactOffsets[r];
+    }
+
+    std::vector<int> compact(compactOffsets[rows]);
+    pool.parallelFor(rows, kTaskGrain,
+                     [&](int begin, int end)
+                     {
+                         for (int r = begin; r < end; ++r)
+                         {
+                             std::copy(values.begin() + offsets[r],
+                                       values.begin() + offsets[r] + (compactOffsets[r + 1] - compactOffsets[r]),
+                                       compact.begin() + compactOffsets[r]);
+                         }
+                     });
+    offsets.swap(compactOffsets);
+    values.swap(compact);
+}
+}
+
+EdgeList EdgeListParser::parse(std::string_view text, int taskCount, bool removeDuplicates, ThreadPool& pool)
+{
+    taskCount = std::max(0, taskCount);
+    const int chunkCount = text.size() < kParallelThreshold ? 1 : pool.threadCount();
+    std::vector<Chunk> chunks = splitAtWhitespace(text, chunkCount);
+
+    // 1. Every chunk scans its numbers.
+    pool.parallelFor(chunkCount, 1,
+                     [&](int begin, int end)
+                     {
+                         for (int c = begin; c < end; ++c)
+                         {
+                             Chunk& chunk = chunks[c];
+                             chunk.tokens.reserve(chunk.text.size() / 4);
+                             NumberScanner scanner(chunk.text);
+                             int value;
+                             while (scanner.read(value))
+                             {
+                                 chunk.tokens.push_back(value);
+                             }
+                             chunk.malformed = !scanner.atEnd();
+                         }
+                     });
+
+    // 2. Global token positions; everything after the first malformed token is ignored.
+    int usableChunks = chunkCount;
+    std::size_t tokenCount = 0;
+    for (int c = 0; c < chunkCount; ++c)
+    {
+        chunks[c].firstToken = tokenCount;
+        tokenCount += chunks[c].tokens.size();
+        if (chunks[c].malformed)
+        {
+            usableChunks = c + 1;
+            break;
+        }
+    }
+    const std::size_t pairedTokens = tokenCount / 2 * 2;
+
+    auto tokenAt = [&](std::size_t position)
+    {
+        const auto owner = std::upper_bound(chunks.begin(), chunks.begin() + usableChunks, position,
+                                            [](std::size_t value, const Chunk& chunk) { return value < chunk.firstToken; }) - 1;
+        return owner->tokens[position - owner->firstToken];
+    };
+
+    // 3. Pairs starting in each chunk (the second id may sit in a later chunk),
+    // bucketed by the task range of their predecessor and, separately, of
+    // their successor. Only the pairs are touched: nothing per chunk is N sized.
+    const TaskRanges ranges(taskCount, pool.threadCount() * kRangesPerThread);
+    pool.parallelFor(usableChunks, 1,
+                     [&](int begin, int end)
+                     {
+                         std::vector<int> pairs;
+                         for (int c = begin; c < end; ++c)
+                         {
+                             Chunk& chunk = chunks[c];
+                             pairs.clear();
+                             const std::size_t size = chunk.tokens.size();
+                             for (std::size_t i = chunk.firstToken % 2; i < size && chunk.firstToken + i < pairedTokens; i += 2)
+                             {
+                                 const int pred = chunk.tokens[i];
+                                 const int succ = i + 1 < size ? chunk.tokens[i + 1] : tokenAt(chunk.firstToken + i + 1);
+                                 if (pred >= 1 && pred <= taskCount && succ >= 1 && succ <= taskCount)
+                                 {
+                                     pairs.push_back(pred);
+                                     pairs.push_back(succ);
+                                 }
+                             }
+                             bucketPairs(pairs, Successors, ranges, chunk.buckets[Successors]);
+                             bucketPairs(pairs, Predecessors, ranges, chunk.buckets[Predecessors]);
+                         }
+                     });
+    for (Chunk& chunk : chunks)
+    {
+        std::vector<int>().swap(chunk.tokens); // pairs may straddle chunks, so only now
+    }
+
+    // 4. Every task range is built on its own: row counts from its buckets,
+    // offsets from the pairs of the ranges before it, then the scatter in chunk
+    // order, which keeps every row in input order.
+    std::vector<int> bases[2] = {std::vector<int>(ranges.count + 1, 0), std::vector<int>(ranges.count + 1, 0)};
+    for (int side : {Successors, Predecessors})
+    {
+        for (int range = 0; range < ranges.count; ++range)
+        {
+            bases[side][range + 1] = bases[side][range];
+            for (int c = 0; c < usableChunks; ++c)
+            {
+                const Buckets& buckets = chunks[c].buckets[side];
+                bases[side][range + 1] += buckets.offsets[range + 1] - buckets.offsets[range];
+            }
+        }
+    }
+
+    EdgeList edges;
+    edges.successorOffsets.assign(taskCount + 1, 0);
+    edges.predecessorOffsets.assign(taskCount + 1, 0);
+    edges.successors.resize(bases[Successors][ranges.count]);
+    edges.predecessors.resize(bases[Predecessors][ranges.count]);
+    std::vector<int> cursors[2] = {std::vector<int>(taskCount), std::vector<int>(taskCount)};
+    pool.parallelFor(ranges.count, 1,
+                     [&](int begin, int end)
+                     {
+                         for (int range = begin; range < end; ++range)
+                         {
+                             buildRows(chunks, usableChunks, ranges, range, Successors, bases[Successors][range],
+                                       edges.successorOffsets, edges.successors, cursors[Successors].data());
+                             buildRows(chunks, usableChunks, ranges, range, Predecessors, bases[Predecessors][range],
+                                       edges.predecessorOffsets, edges.predecessors, cursors[Predecessors].data());
+                         }
+                     });
+
+    if (removeDuplicates)
+    {
+        removeRepeatedEntries(edges.successorOffsets, edges.successors, pool);
+        removeRepeatedEntries(edges.predecessorOffsets, edges.predecessors, pool);
+    }
+    return edges;
+}
@@ -0,0 +1,45 @@
+#ifndef EDGE_LIST_PARSER_H
+#define EDGE_LIST_PARSER_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+class ThreadPool;
+
+struct LoadOptions
+{
+    int threadCount = 0;               // 0 = one thread per hardware core
+    bool removeDuplicateEdges = false; // keep only the first of repeated "pred succ" pairs
+};
+
+// Dependencies of tasks 1..N in CSR form: the successor ids of task `id` are
+// successors[successorOffsets[id - 1] .. successorOffsets[id]), in input order;
+// predecessors likewise.
+struct EdgeList
+{
+    std::vector<int> successorOffsets;
+    std::vector<int> successors;
+    std::vector<int> predecessorOffsets;
+    std::vector<int> predecessors;
+};
+
+// Parses the "pred succ pred succ ..." dependency line of the text formats.
+// The text is split into one chunk per thread at whitespace; each chunk is
+// scanned into its own token buffer, and the pairs (which may straddle chunks)
+// are bucketed per chunk by task range, a few ranges per thread. Every range
+// then counts, offsets and scatters its own rows from the buckets in chunk
+// order, a stable counting sort into CSR in which every thread takes part
+// whatever the ratio of pairs to N, with O(pairs + N) memory. The result matches a serial `while (ss >> pred >> succ)` loop: parsing
+// stops at the first malformed token and pairs with an id outside 1..N are
+// dropped.
+class EdgeListParser
+{
+public:
+    // Lines shorter than this are parsed on the calling thread.
+    static constexpr std::size_t kParallelThreshold = std::size_t{1} << 20;
+
+    static EdgeList parse(std::string_view text, int taskCount, bool removeDuplicates, ThreadPool& pool);
+};
+
+#endif // EDGE_LIST_PARSER_H
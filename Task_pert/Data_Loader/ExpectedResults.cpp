@@ -0,0 +1,204 @@
+#include "ExpectedResults.h"
+#include "InputBuffer.h"
+#include "TextScanner.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+enum class Section
+{
+	Data,
+	ProcessTime,
+	Schedule,
+	CriticalPath,
+	PertPath,
+	PertMoments,
+	PertProbability,
+	PertTargetTime,
+	Other
+};
+
+bool starts_with(std::string_view line, std::string_view prefix)
+{
+    return line.substr(0, prefix.size()) == prefix;
+}
+
+bool contains(std::string_view line, std::string_view marker)
+{
+    return line.find(marker) != std::string_view::npos;
+}
+
+// Reads an "n: id id ..." line; false when the line has another shape.
+bool read_path(std::string_view line, std::vector<int>& path)
+{
+	const std::size_t colon = line.find(':');
+	if (colon == std::string_view::npos)
+	{
+		return false;
+	}
+
+	NumberScanner count_scanner(line.substr(0, colon));
+	int count = 0;
+	if (!count_scanner.read(count) || !count_scanner.atEnd() || count < 0)
+	{
+		return false;
+	}
+
+	NumberScanner ids(line.substr(colon + 1));
+	path.clear();
+	int id;
+	while (ids.read(id))
+	{
+		path.push_back(id);
+	}
+	return ids.atEnd() && static_cast<int>(path.size()) == count;
+}
+}
+
+ExpectedResults ExpectedResultsLoader::read_data(const std::string& filename)
+{
+	ExpectedResults results;
+
+	const InputBuffer input(filename);
+	if (!input.isOpen())
+	{
+		std::cerr << "Error: Could not open file: " << filename << std::endl;
+		results.success = false;
+		return results;
+	}
+
+	LineScanner lines(input.text());
+	std::string_view line;
+	Section section = Section::Data;
+	int data_line_index = 0;
+	int N = 0;
+
+	while (lines.next(line))
+	{
+		if (line.empty())
+		{
+			continue;
+		}
+
+		if (starts_with(line, "process time") || starts_with(line, "Process time"))
+		{
+			section = Section::ProcessTime;
+			continue;
+		}
+		if (contains(line, "earlyStart"))
+		{
+			section = Section::Schedule;
+			results.schedule.clear();
+			continue;
+		}
+		if (contains(line, "critical path:"))
+		{
+			section = Section::CriticalPath;
+			results.criticalPath.clear();
+			continue;
+		}
+		if (contains(line, "out:"))
+		{
+			section = results.format == ProjectFormat::Pert ? Section::PertPath : Section::Other;
+			continue;
+		}
+		if (contains(line, "in:"))
+		{
+			// Either the heading of the data itself or of its description, whose
+			// lines count as ignored data lines, as in the loaders.
+			section = Section::Data;
+			continue;
+		}
+
+		NumberScanner ss(line);
+		switch (section)
+		{
+		case Section::Data:
+			data_line_index++;
+			if (data_line_index == 1)
+			{
+				int M = 0;
+				if (!ss.read(N, M) || N <= 0)
+				{
+					return results;
+				}
+			}
+			else if (data_line_index == 2)
+			{
+				// N durations or N triples: one number more than N is enough to tell
+				int value;
+				int count = 0;
+				while (count <= N && ss.read(value))
+				{
+					++count;
+				}
+				results.format = count == N ? ProjectFormat::Cpm : count > N ? ProjectFormat::Pert : ProjectFormat::Unknown;
+			}
+			break;
+
+		case Section::ProcessTime:
+			results.hasProcessTime = ss.read(results.processTime);
+			section = Section::Other;
+			break;
+
+		case Section::Schedule:
+		{
+			ExpectedTimes times;
+			if (ss.read(times.earlyStart, times.earlyFinish, times.lateStart, times.lateFinish))
+			{
+				results.schedule.push_back(times);
+			}
+			else
+			{
+				section = Section::Other;
+			}
+			break;
+		}
+
+		case Section::CriticalPath:
+		{
+			ExpectedCriticalTask task;
+			if (ss.read(task.id, task.earlyStart, task.earlyFinish))
+			{
+				results.criticalPath.push_back(task);
+			}
+			else
+			{
+				section = Section::Other;
+			}
+			break;
+		}
+
+		case Section::PertPath:
+			section = read_path(line, results.pertCriticalPath) ? Section::PertMoments : Section::Other;
+			break;
+
+		case Section::PertMoments:
+			section = ss.read(results.expectedDuration, results.standardDeviation) ? Section::PertProbability : Section::Other;
+			break;
+
+		case Section::PertProbability:
+			section = ss.read(results.onTimeProbability) ? Section::PertTargetTime : Section::Other;
+			break;
+
+		case Section::PertTargetTime:
+			results.hasPertSolution = ss.read(results.targetProbabilityTime);
+			section = Section::Other;
+			break;
+
+		case Section::Other:
+			break;
+		}
+	}
+
+	if (static_cast<int>(results.schedule.size()) != N)
+	{
+		results.schedule.clear();
+	}
+
+	results.success = results.format != ProjectFormat::Unknown;
+	return results;
+}
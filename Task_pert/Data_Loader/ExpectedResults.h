@@ -0,0 +1,58 @@
+#ifndef EXPECTED_RESULTS_H
+#define EXPECTED_RESULTS_H
+
+#include <string>
+#include <vector>
+
+enum class ProjectFormat
+{
+	Unknown,
+	Cpm,  // second data line holds N durations
+	Pert  // second data line holds N (optimistic, most likely, pessimistic) triples
+};
+
+struct ExpectedTimes
+{
+	int earlyStart = 0;
+	int earlyFinish = 0;
+	int lateStart = 0;
+	int lateFinish = 0;
+};
+
+struct ExpectedCriticalTask
+{
+	int id = 0;
+	int earlyStart = 0;
+	int earlyFinish = 0;
+};
+
+// Reference solution carried next to the data of a text file.
+struct ExpectedResults
+{
+	ProjectFormat format = ProjectFormat::Unknown;
+	bool success = false; // reading status
+
+	// CPM: "process time:", "earlyStart earlyFinish lateStart lateFinish:" and "critical path:"
+	bool hasProcessTime = false;
+	int processTime = 0;
+	std::vector<ExpectedTimes> schedule; // task ids 1..N in order; empty when absent
+	std::vector<ExpectedCriticalTask> criticalPath;
+
+	// PERT: the numeric "out:" block ("count: ids", "mean stddev", probability, duration)
+	bool hasPertSolution = false;
+	std::vector<int> pertCriticalPath;
+	double expectedDuration = 0.0;
+	double standardDeviation = 0.0;
+	double onTimeProbability = 0.0;       // P(T <= target time)
+	double targetProbabilityTime = 0.0;   // duration met with the target probability
+};
+
+// Detects the format of a project file and reads its reference sections.
+// Only the first tokens of the data lines are looked at, so this is cheap
+// next to loading the project.
+class ExpectedResultsLoader
+{
+public:
+	static ExpectedResults read_data(const std::string& filename);
+};
+#endif // !EXPECTED_RESULTS_H
@@ -0,0 +1,171 @@
+#include "InputBuffer.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Appends everything `readChunk(buffer, capacity)` yields until it returns 0
+// (end of input) or a negative value (error).
+template <typename ReadChunk>
+bool readAll(std::vector<char>& buffer, const ReadChunk& readChunk)
+{
+    std::size_t size = 0;
+    while (true)
+    {
+        buffer.resize(size + InputBuffer::kStreamChunkSize);
+        const long long count = readChunk(buffer.data() + size, InputBuffer::kStreamChunkSize);
+        if (count < 0)
+        {
+            buffer.clear();
+            return false;
+        }
+        if (count == 0)
+        {
+            break;
+        }
+        size += static_cast<std::size_t>(count);
+    }
+    buffer.resize(size);
+    return true;
+}
+}
+
+#if defined(_WIN32)
+
+InputBuffer::InputBuffer(const std::string& filename)
+{
+    const bool fromStdin = filename == kStdinName;
+    HANDLE file = fromStdin ? ::GetStdHandle(STD_INPUT_HANDLE)
+                            : ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE || file == nullptr)
+    {
+        return;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (::GetFileType(file) == FILE_TYPE_DISK && ::GetFileSizeEx(file, &fileSize))
+    {
+        if (fileSize.QuadPart == 0)
+        {
+            open_ = true;
+        }
+        else if (HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+        {
+            // The view keeps the mapping alive after both handles are closed.
+            mapping_ = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            ::CloseHandle(mapping);
+            if (mapping_ != nullptr)
+            {
+                data_ = static_cast<const char*>(mapping_);
+                size_ = mappedSize_ = static_cast<std::size_t>(fileSize.QuadPart);
+                open_ = true;
+            }
+        }
+    }
+
+    if (!open_)
+    {
+        open_ = readAll(streamed_,
+                        [file](char* buffer, std::size_t capacity) -> long long
+                        {
+                            DWORD count = 0;
+                            if (!::ReadFile(file, buffer, static_cast<DWORD>(capacity), &count, nullptr))
+                            {
+                                // A closed pipe ends the input like end of file does.
+                                return ::GetLastError() == ERROR_BROKEN_PIPE ? 0 : -1;
+                            }
+                            return count;
+                        });
+        data_ = streamed_.data();
+        size_ = streamed_.size();
+    }
+
+    if (!fromStdin)
+    {
+        ::CloseHandle(file);
+    }
+}
+
+InputBuffer::~InputBuffer()
+{
+    if (mapping_ != nullptr)
+    {
+        ::UnmapViewOfFile(mapping_);
+    }
+}
+
+#else
+
+InputBuffer::InputBuffer(const std::string& filename)
+{
+    const bool fromStdin = filename == kStdinName;
+    const int fd = fromStdin ? STDIN_FILENO : ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct stat status{};
+    if (::fstat(fd, &status) == 0 && S_ISREG(status.st_mode))
+    {
+        if (status.st_size == 0)
+        {
+            open_ = true;
+        }
+        else
+        {
+            void* view = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED)
+            {
+                ::madvise(view, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+                mapping_ = view;
+                data_ = static_cast<const char*>(view);
+                size_ = mappedSize_ = static_cast<std::size_t>(status.st_size);
+                open_ = true;
+            }
+        }
+    }
+
+    if (!open_)
+    {
+        open_ = readAll(streamed_,
+                        [fd](char* buffer, std::size_t capacity) -> long long
+                        {
+                            ssize_t count;
+                            do
+                            {
+                                count = ::read(fd, buffer, capacity);
+                            } while (count < 0 && errno == EINTR);
+                            return count;
+                        });
+        data_ = streamed_.data();
+        size_ = streamed_.size();
+    }
+
+    if (!fromStdin)
+    {
+        ::close(fd);
+    }
+}
+
+InputBuffer::~InputBuffer()
+{
+    if (mapping_ != nullptr)
+    {
+        ::munmap(mapping_, mappedSize_);
+    }
+}
+
+#endif
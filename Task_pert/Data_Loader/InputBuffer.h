@@ -0,0 +1,36 @@
+#ifndef INPUT_BUFFER_H
+#define INPUT_BUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read-only view of a whole input file for the loaders. Regular files are
+// memory-mapped and parsed in place; "-" (stdin), pipes and other inputs that
+// cannot be mapped are streamed into an owned buffer in kStreamChunkSize reads.
+class InputBuffer
+{
+public:
+    static constexpr const char* kStdinName = "-";
+    static constexpr std::size_t kStreamChunkSize = std::size_t{1} << 20;
+
+    explicit InputBuffer(const std::string& filename);
+    ~InputBuffer();
+
+    InputBuffer(const InputBuffer&) = delete;
+    InputBuffer& operator=(const InputBuffer&) = delete;
+
+    bool isOpen() const { return open_; }
+    std::string_view text() const { return {data_, size_}; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool open_ = false;
+    void* mapping_ = nullptr; // base of the mapped view; null when the text lives in streamed_
+    std::size_t mappedSize_ = 0;
+    std::vector<char> streamed_;
+};
+
+#endif // INPUT_BUFFER_H
@@ -0,0 +1,267 @@
+#include "ProjectSnapshot.h"
+#include "InputBuffer.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+constexpr std::uint64_t kSectionAlignment = 8;
+
+static_assert(sizeof(SnapshotHeader) == 64 + SectionCount * sizeof(SnapshotHeader::Section),
+              "the header is written as is and must not contain padding");
+
+std::uint64_t align_up(std::uint64_t value)
+{
+    return (value + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+}
+
+template <typename T>
+ArrayView<T> section_view(const SnapshotHeader& header, SnapshotSection section, std::string_view file)
+{
+    const SnapshotHeader::Section& bounds = header.sections[section];
+    return {reinterpret_cast<const T*>(file.data() + bounds.offset), static_cast<std::size_t>(bounds.count)};
+}
+
+template <typename T>
+bool section_fits(const SnapshotHeader& header, SnapshotSection section, std::uint64_t expected_count, std::size_t file_size)
+{
+    const SnapshotHeader::Section& bounds = header.sections[section];
+    return bounds.count == expected_count &&
+           bounds.offset % alignof(T) == 0 &&
+           bounds.offset >= sizeof(SnapshotHeader) &&
+           bounds.offset <= file_size &&
+           bounds.count <= (file_size - bounds.offset) / sizeof(T);
+}
+
+bool valid_header(const SnapshotHeader& header, std::size_t file_size)
+{
+    if (std::memcmp(header.magic, SnapshotHeader::kMagic, sizeof(header.magic)) != 0 ||
+        header.version != SnapshotHeader::kVersion ||
+        header.byteOrder != SnapshotHeader::kByteOrderMark ||
+        header.taskCount < 0 || header.edgeCount < 0)
+    {
+        return false;
+    }
+
+    const std::uint64_t tasks = static_cast<std::uint64_t>(header.taskCount);
+    const std::uint64_t edges = static_cast<std::uint64_t>(header.edgeCount);
+    const std::uint64_t scheduled = header.sections[TopologicalOrder].count;
+    const std::uint64_t levels = header.sections[LevelOffsets].count;
+    const bool pert = header.kind == SnapshotKind::Pert;
+    if ((!pert && header.kind != SnapshotKind::Cpm) || scheduled > tasks || levels == 0)
+    {
+        return false;
+    }
+
+    return section_fits<int>(header, TaskIds, tasks, file_size) &&
+           section_fits<int>(header, SuccessorOffsets, tasks + 1, file_size) &&
+           section_fits<int>(header, SuccessorIndices, edges, file_size) &&
+           section_fits<int>(header, PredecessorOffsets, tasks + 1, file_size) &&
+           section_fits<int>(header, PredecessorIndices, edges, file_size) &&
+           section_fits<int>(header, TopologicalOrder, scheduled, file_size) &&
+           section_fits<int>(header, LevelOffsets, levels, file_size) &&
+           section_fits<int>(header, LevelOrder, scheduled, file_size) &&
+           section_fits<int>(header, Durations, pert ? 0 : tasks, file_size) &&
+           section_fits<int>(header, OptimisticTimes, pert ? tasks : 0, file_size) &&
+           section_fits<int>(header, MostLikelyTimes, pert ? tasks : 0, file_size) &&
+           section_fits<int>(header, PessimisticTimes, pert ? tasks : 0, file_size) &&
+           section_fits<double>(header, ExpectedDurations, pert ? tasks : 0, file_size) &&
+           section_fits<double>(header, Variances, pert ? tasks : 0, file_size);
+}
+
+// Offsets from 0 to `last`, never decreasing.
+bool valid_offsets(ArrayView<int> offsets, int last)
+{
+    if (offsets[0] != 0 || offsets[offsets.size() - 1] != last)
+    {
+        return false;
+    }
+    for (std::size_t i = 1; i < offsets.size(); ++i)
+    {
+        if (offsets[i] < offsets[i - 1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool valid_indices(ArrayView<int> indices, int task_count)
+{
+    for (int index : indices)
+    {
+        if (index < 0 || index >= task_count)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The graph accessors index the sections with these values unchecked, so a
+// truncated or corrupt file has to be caught here: one linear pass over the
+// mapped offsets and indices.
+bool consistent_columns(const ProjectGraph::Columns& columns, int edge_count)
+{
+    const int tasks = static_cast<int>(columns.taskIds.size());
+    return valid_offsets(columns.successorOffsets, edge_count) &&
+           valid_offsets(columns.predecessorOffsets, edge_count) &&
+           valid_offsets(columns.levelOffsets, static_cast<int>(columns.levelOrder.size())) &&
+           valid_indices(columns.successorIndices, tasks) &&
+           valid_indices(columns.predecessorIndices, tasks) &&
+           valid_indices(columns.topologicalOrder, tasks) &&
+           valid_indices(columns.levelOrder, tasks);
+}
+
+bool write_snapshot(const std::string& filename, SnapshotHeader header, const ProjectGraph& graph)
+{
+    const ProjectGraph::Columns columns = graph.columns();
+    std::memcpy(header.magic, SnapshotHeader::kMagic, sizeof(header.magic));
+    header.version = SnapshotHeader::kVersion;
+    header.byteOrder = SnapshotHeader::kByteOrderMark;
+    header.taskCount = graph.size();
+    header.edgeCount = graph.edgeCount();
+
+    struct Payload
+    {
+        const void* data;
+        std::uint64_t count;
+        std::uint64_t elementSize;
+    };
+    const Payload payloads[SectionCount] = {
+        {columns.taskIds.data(), columns.taskIds.size(), sizeof(int)},
+        {columns.successorOffsets.data(), columns.successorOffsets.size(), sizeof(int)},
+        {columns.successorIndices.data(), columns.successorIndices.size(), sizeof(int)},
+        {columns.predecessorOffsets.data(), columns.predecessorOffsets.size(), sizeof(int)},
+        {columns.predecessorIndices.data(), columns.predecessorIndices.size(), sizeof(int)},
+        {columns.topologicalOrder.data(), columns.topologicalOrder.size(), sizeof(int)},
+        {columns.levelOffsets.data(), columns.levelOffsets.size(), sizeof(int)},
+        {columns.levelOrder.data(), columns.levelOrder.size(), sizeof(int)},
+        {columns.durations.data(), columns.durations.size(), sizeof(int)},
+        {columns.optimisticTimes.data(), columns.optimisticTimes.size(), sizeof(int)},
+        {columns.mostLikelyTimes.data(), columns.mostLikelyTimes.size(), sizeof(int)},
+        {columns.pessimisticTimes.data(), columns.pessimisticTimes.size(), sizeof(int)},
+        {columns.expectedDurations.data(), columns.expectedDurations.size(), sizeof(double)},
+        {columns.variances.data(), columns.variances.size(), sizeof(double)},
+    };
+
+    std::uint64_t offset = align_up(sizeof(SnapshotHeader));
+    for (int section = 0; section < static_cast<int>(SectionCount); ++section)
+    {
+        header.sections[section].offset = offset;
+        header.sections[section].count = payloads[section].count;
+        offset = align_up(offset + payloads[section].count * payloads[section].elementSize);
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "Error: Could not create file: " << filename << std::endl;
+        return false;
+    }
+
+    const char padding[kSectionAlignment] = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::uint64_t written = sizeof(header);
+    for (int section = 0; section < static_cast<int>(SectionCount); ++section)
+    {
+        file.write(padding, static_cast<std::streamsize>(header.sections[section].offset - written));
+        const std::uint64_t bytes = payloads[section].count * payloads[section].elementSize;
+        if (bytes > 0)
+        {
+            file.write(static_cast<const char*>(payloads[section].data), static_cast<std::streamsize>(bytes));
+        }
+        written = header.sections[section].offset + bytes;
+    }
+
+    if (!file)
+    {
+        std::cerr << "Error: Failed to write snapshot: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+}
+
+ProjectSnapshot SnapshotLoader::read_data(const std::string& filename)
+{
+    ProjectSnapshot data;
+
+    auto input = std::make_shared<const InputBuffer>(filename);
+    if (!input->isOpen())
+    {
+        std::cerr << "Error: Could not open file: " << filename << std::endl;
+        return data;
+    }
+
+    const std::string_view file = input->text();
+    SnapshotHeader header;
+    if (file.size() < sizeof(header))
+    {
+        std::cerr << "Error: Not a project snapshot: " << filename << std::endl;
+        return data;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (!valid_header(header, file.size()))
+    {
+        std::cerr << "Error: Not a project snapshot or unsupported version: " << filename << std::endl;
+        return data;
+    }
+
+    ProjectGraph::Columns columns;
+    columns.taskIds = section_view<int>(header, TaskIds, file);
+    columns.successorOffsets = section_view<int>(header, SuccessorOffsets, file);
+    columns.successorIndices = section_view<int>(header, SuccessorIndices, file);
+    columns.predecessorOffsets = section_view<int>(header, PredecessorOffsets, file);
+    columns.predecessorIndices = section_view<int>(header, PredecessorIndices, file);
+    columns.topologicalOrder = section_view<int>(header, TopologicalOrder, file);
+    columns.levelOffsets = section_view<int>(header, LevelOffsets, file);
+    columns.levelOrder = section_view<int>(header, LevelOrder, file);
+    columns.durations = section_view<int>(header, Durations, file);
+    columns.optimisticTimes = section_view<int>(header, OptimisticTimes, file);
+    columns.mostLikelyTimes = section_view<int>(header, MostLikelyTimes, file);
+    columns.pessimisticTimes = section_view<int>(header, PessimisticTimes, file);
+    columns.expectedDurations = section_view<double>(header, ExpectedDurations, file);
+    columns.variances = section_view<double>(header, Variances, file);
+    if (!consistent_columns(columns, header.edgeCount))
+    {
+        std::cerr << "Error: Corrupt project snapshot: " << filename << std::endl;
+        return data;
+    }
+
+    data.kind = header.kind;
+    data.N = header.declaredTaskCount;
+    data.M = header.declaredDependencyCount;
+    data.expectedProcessTime = header.expectedProcessTime;
+    data.hasExpectedProcessTime = header.hasExpectedProcessTime != 0;
+    data.target_time = header.targetTime;
+    data.target_probability = header.targetProbability;
+    data.graph = ProjectGraph::attach(columns, std::move(input));
+    data.success = true;
+    return data;
+}
+
+bool SnapshotLoader::write_data(const std::string& filename, const ProjectData& data)
+{
+    SnapshotHeader header;
+    header.kind = SnapshotKind::Cpm;
+    header.declaredTaskCount = data.N;
+    header.declaredDependencyCount = data.M;
+    header.expectedProcessTime = data.expectedProcessTime;
+    header.hasExpectedProcessTime = data.hasExpectedProcessTime ? 1 : 0;
+    return write_snapshot(filename, header, ProjectGraph::compile(data.tasks));
+}
+
+bool SnapshotLoader::write_data(const std::string& filename, const ProjectDataPert& data)
+{
+    SnapshotHeader header;
+    header.kind = SnapshotKind::Pert;
+    header.declaredTaskCount = data.N;
+    header.declaredDependencyCount = data.M;
+    header.targetTime = data.target_time;
+    header.targetProbability = data.target_probability;
+    return write_snapshot(filename, header, ProjectGraph::compile(data.tasks));
+}
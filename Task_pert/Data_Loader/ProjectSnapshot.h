@@ -0,0 +1,98 @@
+#ifndef PROJECT_SNAPSHOT_H
+#define PROJECT_SNAPSHOT_H
+
+#include "DataLoader.h"
+#include "DataLoader_pert.h"
+#include "ProjectGraph.h"
+
+#include <cstdint>
+#include <string>
+
+// Versioned binary image of a compiled ProjectGraph plus the metadata of the
+// text formats. read_data memory-maps the file and the graph uses the arrays
+// in place: nothing is parsed, copied or recomputed, so opening takes as long
+// as mapping the file.
+//
+// Layout (native little-endian): SnapshotHeader, then one 8-byte aligned
+// section per SnapshotSection holding the matching ProjectGraph column. On load
+// the header and section bounds are validated, then one linear pass checks
+// that the offsets are monotonic and every task index is in range.
+enum class SnapshotKind : std::uint32_t
+{
+    Cpm = 1,  // durations column
+    Pert = 2, // optimistic / most likely / pessimistic, expected duration and variance columns
+};
+
+enum SnapshotSection : std::uint32_t
+{
+    TaskIds,
+    SuccessorOffsets,
+    SuccessorIndices,
+    PredecessorOffsets,
+    PredecessorIndices,
+    TopologicalOrder,
+    LevelOffsets,
+    LevelOrder,
+    Durations,
+    OptimisticTimes,
+    MostLikelyTimes,
+    PessimisticTimes,
+    ExpectedDurations,
+    Variances,
+    SectionCount
+};
+
+struct SnapshotHeader
+{
+    static constexpr char kMagic[8] = {'B', 'O', 'i', 'O', 'D', 'P', 'G', 'S'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+    struct Section
+    {
+        std::uint64_t offset = 0; // from the start of the file
+        std::uint64_t count = 0;  // elements
+    };
+
+    char magic[8] = {};
+    std::uint32_t version = 0;
+    std::uint32_t byteOrder = 0;
+    SnapshotKind kind = SnapshotKind::Cpm;
+    std::int32_t taskCount = 0;
+    std::int32_t edgeCount = 0;
+    std::int32_t declaredTaskCount = 0;       // N and M of the source text file
+    std::int32_t declaredDependencyCount = 0;
+    std::int32_t expectedProcessTime = 0;
+    std::int32_t hasExpectedProcessTime = 0;
+    std::int32_t reserved = 0;
+    double targetTime = 0.0;
+    double targetProbability = 0.0;
+    Section sections[SectionCount];
+};
+
+struct ProjectSnapshot
+{
+    SnapshotKind kind = SnapshotKind::Cpm;
+    int N = 0; // number of tasks
+    int M = 0; // number of dependencies
+    ProjectGraph graph;
+    bool success = false; // reading status
+
+    int expectedProcessTime = 0; // CPM
+    bool hasExpectedProcessTime = false;
+
+    double target_time = 0.0; // PERT
+    double target_probability = 0.0;
+};
+
+class SnapshotLoader
+{
+public:
+    static ProjectSnapshot read_data(const std::string& filename);
+
+    // Compiles the loaded project and writes its snapshot; false on I/O errors.
+    static bool write_data(const std::string& filename, const ProjectData& data);
+    static bool write_data(const std::string& filename, const ProjectDataPert& data);
+};
+
+#endif // PROJECT_SNAPSHOT_H
@@ -0,0 +1,235 @@
+#ifndef TEXT_SCANNER_H
+#define TEXT_SCANNER_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <system_error>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Eight digits at a time when unaligned little-endian 64-bit loads are available.
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define TEXT_SCANNER_SWAR 1
+#else
+#define TEXT_SCANNER_SWAR 0
+#endif
+
+// In-place scanning shared by DataLoader and DataLoader_pert. LineScanner
+// splits the text into trimmed lines and NumberScanner reads the numbers of
+// one line the way `std::stringstream >>` did, without copying anything.
+
+class LineScanner
+{
+public:
+    explicit LineScanner(std::string_view text)
+        : cursor_(text.data()), end_(text.data() + text.size())
+    {
+    }
+
+    // Next line without its terminator, a leading UTF-8 BOM and surrounding
+    // whitespace; false at the end of the text.
+    bool next(std::string_view& line)
+    {
+        if (cursor_ == end_)
+        {
+            return false;
+        }
+
+        const char* first = cursor_;
+        const char* newline = static_cast<const char*>(std::memchr(first, '\n', end_ - first));
+        const char* last = newline != nullptr ? newline : end_;
+        cursor_ = newline != nullptr ? newline + 1 : end_;
+
+        if (last - first >= 3 && static_cast<unsigned char>(first[0]) == 0xEF &&
+            static_cast<unsigned char>(first[1]) == 0xBB &&
+            static_cast<unsigned char>(first[2]) == 0xBF)
+        {
+            first += 3;
+        }
+        while (first != last && isSpace(*first))
+        {
+            ++first;
+        }
+        while (last != first && isSpace(last[-1]))
+        {
+            --last;
+        }
+        line = std::string_view(first, static_cast<std::size_t>(last - first));
+        return true;
+    }
+
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+    }
+
+private:
+    const char* cursor_;
+    const char* end_;
+};
+
+// Section headers and solution blocks that the input files carry next to the data.
+inline bool isMetadataLine(std::string_view line)
+{
+    // Every marker contains ':' or an 'S'; number lines are rejected by two memchr scans.
+    if (line.find(':') == std::string_view::npos && line.find('S') == std::string_view::npos)
+    {
+        return false;
+    }
+    return line.find("in:") != std::string_view::npos ||
+           line.find("out:") != std::string_view::npos ||
+           line.find("process time:") != std::string_view::npos ||
+           line.find("earlyStart") != std::string_view::npos ||
+           line.find("critical path:") != std::string_view::npos;
+}
+
+class NumberScanner
+{
+public:
+    explicit NumberScanner(std::string_view line)
+        : cursor_(line.data()), end_(line.data() + line.size())
+    {
+    }
+
+    // Skips whitespace and reads one number; false when the next token is
+    // missing, malformed or out of range, with `value` set as `std::istream >>`
+    // sets it (0, or the nearest limit on integer overflow).
+    bool read(int& value)
+    {
+        skipSpaces();
+        const char* p = cursor_;
+        bool negative = false;
+        if (p != end_ && (*p == '-' || *p == '+'))
+        {
+            negative = *p == '-';
+            ++p;
+        }
+
+        const char* digits = p;
+        while (p != end_ && *p == '0')
+        {
+            ++p;
+        }
+        const char* significant = p;
+        std::uint64_t magnitude = 0;
+#if TEXT_SCANNER_SWAR
+        if (end_ - p >= 8)
+        {
+            p += leadingDigits(p, magnitude);
+        }
+#endif
+        while (p != end_ && static_cast<unsigned char>(*p - '0') < 10)
+        {
+            magnitude = magnitude * 10 + static_cast<unsigned char>(*p - '0');
+            ++p;
+        }
+        if (p == digits)
+        {
+            value = 0;
+            return false;
+        }
+        // Past ten significant digits the accumulator may have wrapped, but the value overflows anyway.
+        const std::uint64_t limit = negative ? 2147483648ULL : 2147483647ULL;
+        if (p - significant > 10 || magnitude > limit)
+        {
+            value = negative ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+            return false;
+        }
+
+        value = negative ? static_cast<int>(-static_cast<std::int64_t>(magnitude)) : static_cast<int>(magnitude);
+        cursor_ = p;
+        return true;
+    }
+
+    bool read(double& value)
+    {
+        skipSpaces();
+        const char* p = cursor_;
+        if (p != end_ && *p == '+')
+        {
+            ++p;
+        }
+        double parsed = 0.0;
+        const std::from_chars_result result = std::from_chars(p, end_, parsed);
+        if (result.ec != std::errc() || (p != cursor_ && *p == '-'))
+        {
+            value = 0.0;
+            return false;
+        }
+        value = parsed;
+        cursor_ = result.ptr;
+        return true;
+    }
+
+    template <typename T, typename... Rest>
+    bool read(T& first, Rest&... rest)
+    {
+        return read(first) && read(rest...);
+    }
+
+    // True when only whitespace is left, i.e. a failed read hit the end
+    // rather than a malformed token.
+    bool atEnd()
+    {
+        skipSpaces();
+        return cursor_ == end_;
+    }
+
+private:
+#if TEXT_SCANNER_SWAR
+    // Value of the up to eight digits starting at `p` (which has 8 readable
+    // bytes); returns how many there were.
+    static int leadingDigits(const char* p, std::uint64_t& value)
+    {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, p, sizeof(chunk));
+        chunk ^= 0x3030303030303030ULL; // digits become 0..9, anything else has a byte >= 10
+        // A byte is not a digit when its high nibble is set or adding 6 carries
+        // into it; carries only corrupt bytes after the first non-digit.
+        const std::uint64_t nonDigits = (chunk | (chunk + 0x0606060606060606ULL)) & 0xF0F0F0F0F0F0F0F0ULL;
+        const int count = nonDigits == 0 ? 8 : countTrailingZeros(nonDigits) / 8;
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        // Right-align the digits as an eight-digit number with leading zeros,
+        // then combine pairs, quads and octets.
+        chunk <<= 8 * (8 - count);
+        chunk = chunk * 10 + (chunk >> 8);
+        chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                 (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        value = chunk;
+        return count;
+    }
+
+    static int countTrailingZeros(std::uint64_t value)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+#endif
+
+    void skipSpaces()
+    {
+        while (cursor_ != end_ && LineScanner::isSpace(*cursor_))
+        {
+            ++cursor_;
+        }
+    }
+
+    const char* cursor_;
+    const char* end_;
+};
+
+#endif // TEXT_SCANNER_H
@@ -0,0 +1,245 @@
+#include "ClarkApproximation.h"
+#include "NormalDistribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+constexpr double kInverseSqrtTwoPi = 0.3989422804014327;
+constexpr int kFoldGrowth = 4;
+
+// mean + sum of coefficient * Z_task over `terms` (sorted by task) + an
+// independent remainder, whose variance is what `variance` leaves after the
+// squared coefficients.
+struct CanonicalForm
+{
+    double mean = 0.0;
+    double variance = 0.0;
+    std::vector<std::pair<int, double>> terms;
+};
+
+double covariance(const CanonicalForm& x, const CanonicalForm& y)
+{
+    double total = 0.0;
+    auto xt = x.terms.begin();
+    auto yt = y.terms.begin();
+    while (xt != x.terms.end() && yt != y.terms.end())
+    {
+        if (xt->first < yt->first)
+        {
+            ++xt;
+        }
+        else if (yt->first < xt->first)
+        {
+            ++yt;
+        }
+        else
+        {
+            total += (xt++)->second * (yt++)->second;
+        }
+    }
+    return total;
+}
+
+// Clark's max; `tightness` receives P(X > Y). Moments are taken relative to
+// y.mean so large means do not cancel out the variance.
+ClarkApproximation::Moments clarkMaximum(const ClarkApproximation::Moments& x,
+                                         const ClarkApproximation::Moments& y,
+                                         double covariance,
+                                         double& tightness)
+{
+    const double spreadSquared = x.variance + y.variance - 2.0 * covariance;
+    if (!(spreadSquared > 1e-12 * (x.variance + y.variance)))
+    {
+        // X - Y is (almost) constant: the max is the larger one.
+        tightness = x.mean >= y.mean ? 1.0 : 0.0;
+        return x.mean >= y.mean ? x : y;
+    }
+
+    const double spread = std::sqrt(spreadSquared);
+    const double gap = x.mean - y.mean;
+    const double alpha = gap / spread;
+    const double density = kInverseSqrtTwoPi * std::exp(-0.5 * alpha * alpha);
+    tightness = standardNormalCDF(alpha);
+
+    const double shiftedMean = gap * tightness + spread * density;
+    const double shiftedSecond = (gap * gap + x.variance) * tightness + y.variance * (1.0 - tightness) +
+                                 gap * spread * density;
+
+    ClarkApproximation::Moments result;
+    result.mean = y.mean + shiftedMean;
+    result.variance = std::max(0.0, shiftedSecond - shiftedMean * shiftedMean);
+    return result;
+}
+
+// Keeps the `limit` largest coefficients, the dropped ones joining the remainder.
+void truncate(CanonicalForm& form, int limit)
+{
+    if (static_cast<int>(form.terms.size()) <= limit)
+    {
+        return;
+    }
+
+    std::nth_element(form.terms.begin(), form.terms.begin() + limit, form.terms.end(),
+                     [](const std::pair<int, double>& lhs, const std::pair<int, double>& rhs)
+                     {
+                         return std::abs(lhs.second) > std::abs(rhs.second);
+                     });
+    form.terms.resize(limit);
+    std::sort(form.terms.begin(), form.terms.end());
+}
+
+// result = max(x, y): Clark's mean and variance, coefficients mixed by the
+// tightness. The result keeps every coefficient of both; the caller truncates.
+void maximumForm(const CanonicalForm& x, const CanonicalForm& y, CanonicalForm& result)
+{
+    double tightness = 0.0;
+    const ClarkApproximation::Moments moments =
+        clarkMaximum({x.mean, x.variance}, {y.mean, y.variance}, covariance(x, y), tightness);
+    if (tightness == 1.0 || tightness == 0.0)
+    {
+        result = tightness == 1.0 ? x : y;
+        return;
+    }
+
+    result.mean = moments.mean;
+    result.variance = moments.variance;
+    result.terms.clear();
+    result.terms.reserve(x.terms.size() + y.terms.size());
+    auto xt = x.terms.begin();
+    auto yt = y.terms.begin();
+    while (xt != x.terms.end() || yt != y.terms.end())
+    {
+        if (yt == y.terms.end() || (xt != x.terms.end() && xt->first < yt->first))
+        {
+            result.terms.emplace_back(xt->first, tightness * xt->second);
+            ++xt;
+        }
+        else if (xt == x.terms.end() || yt->first < xt->first)
+        {
+            result.terms.emplace_back(yt->first, (1.0 - tightness) * yt->second);
+            ++yt;
+        }
+        else
+        {
+            result.terms.emplace_back(xt->first, tightness * xt->second + (1.0 - tightness) * yt->second);
+            ++xt;
+            ++yt;
+        }
+    }
+
+    // Clark's variance stands: the remainder takes what the coefficients do
+    // not explain, or the coefficients shrink when they explain too much.
+    double explained = 0.0;
+    for (const auto& term : result.terms)
+    {
+        explained += term.second * term.second;
+    }
+    if (explained > moments.variance)
+    {
+        const double scale = std::sqrt(moments.variance / explained);
+        for (auto& term : result.terms)
+        {
+            term.second *= scale;
+        }
+    }
+}
+
+// Max over `tasks`, largest mean first so the early folds are the accurate
+// ones. Truncation to `limit` coefficients is left to the caller, except that
+// long folds (many sinks) are cut back whenever they pass kFoldGrowth * limit.
+void maximumOver(std::vector<int>& tasks,
+                 const std::vector<CanonicalForm>& forms,
+                 int limit,
+                 CanonicalForm& result,
+                 CanonicalForm& scratch)
+{
+    std::sort(tasks.begin(), tasks.end(),
+              [&forms](int lhs, int rhs)
+              {
+                  return forms[lhs].mean > forms[rhs].mean;
+              });
+    result = CanonicalForm();
+    if (tasks.size() == 1)
+    {
+        result = forms[tasks.front()];
+    }
+    for (std::size_t k = 1; k < tasks.size(); ++k)
+    {
+        maximumForm(k == 1 ? forms[tasks.front()] : result, forms[tasks[k]], scratch);
+        std::swap(result, scratch);
+        if (result.terms.size() > static_cast<std::size_t>(kFoldGrowth) * limit)
+        {
+            truncate(result, limit);
+        }
+    }
+}
+}
+
+ClarkApproximation::Moments ClarkApproximation::maximum(const Moments& x, const Moments& y, double covariance)
+{
+    double tightness = 0.0;
+    return clarkMaximum(x, y, covariance, tightness);
+}
+
+ClarkApproximation::Moments ClarkApproximation::completion(const ProjectGraph& graph,
+                                                           const std::vector<double>& means,
+                                                           const std::vector<double>& variances,
+                                                           int correlationTerms)
+{
+    const int limit = std::max(0, correlationTerms);
+    const ArrayView<int> topoOrder = graph.topologicalOrder();
+
+    // A finish time is released once its last successor has read it.
+    std::vector<int> pendingReads(graph.size(), 0);
+    for (int index : topoOrder)
+    {
+        for (int predecessor : graph.predecessors(index))
+        {
+            ++pendingReads[predecessor];
+        }
+    }
+
+    std::vector<CanonicalForm> forms(graph.size());
+    std::vector<int> tasks;
+    CanonicalForm scratch;
+    for (int index : topoOrder)
+    {
+        const ArrayView<int> predecessors = graph.predecessors(index);
+        tasks.assign(predecessors.begin(), predecessors.end());
+        CanonicalForm& finish = forms[index];
+        maximumOver(tasks, forms, limit, finish, scratch);
+
+        finish.mean += means[index];
+        finish.variance += variances[index];
+        if (limit > 0 && variances[index] > 0.0)
+        {
+            // Every task is visited once, so its own term is not in the form yet.
+            const std::pair<int, double> term(index, std::sqrt(variances[index]));
+            finish.terms.insert(std::lower_bound(finish.terms.begin(), finish.terms.end(), term), term);
+        }
+        truncate(finish, limit);
+
+        for (int predecessor : predecessors)
+        {
+            if (--pendingReads[predecessor] == 0)
+            {
+                forms[predecessor] = CanonicalForm();
+            }
+        }
+    }
+
+    tasks.clear();
+    for (int index : topoOrder)
+    {
+        if (graph.isSink(index))
+        {
+            tasks.push_back(index);
+        }
+    }
+    CanonicalForm project;
+    maximumOver(tasks, forms, limit, project, scratch);
+    return {project.mean, project.variance};
+}
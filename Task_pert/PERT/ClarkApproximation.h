@@ -0,0 +1,44 @@
+#ifndef CLARK_APPROXIMATION_H
+#define CLARK_APPROXIMATION_H
+
+#include <vector>
+
+#include "ProjectGraph.h"
+
+// Clark's moment matching (Clark 1961) for the project completion time. Every
+// finish time is approximated by a normal variable: a task adds its duration's
+// mean and variance to its start, and the start, the max over the
+// predecessors' finishes, is replaced by the normal with the exact mean and
+// variance of the max of two normals, folding the predecessors in one by one.
+//
+// Finish times that share upstream tasks are correlated, which the max needs
+// to see (two branches behind one long task are nearly the same variable).
+// Each finish is kept in canonical form,
+//     mean + sum_k c_k * Z_k + r * Z_own,
+// with Z_k the standardised duration of upstream task k and an independent
+// remainder r; the max takes the tightness-weighted mix of both forms'
+// coefficients (Sinha & Zhou's linear approximation) and its variance is
+// restored through the remainder. Only the `correlationTerms` largest
+// coefficients are kept, the rest moving into the remainder, so the pass is
+// O((N + M) * correlationTerms); 0 treats every pair as independent.
+namespace ClarkApproximation
+{
+struct Moments
+{
+    double mean = 0.0;
+    double variance = 0.0;
+};
+
+// Mean and variance of max(X, Y) for jointly normal X and Y.
+Moments maximum(const Moments& x, const Moments& y, double covariance);
+
+// Completion-time moments for independent task durations with the given
+// means and variances (indexed like the graph). Tasks on a dependency cycle
+// are ignored; an empty project completes at 0.
+Moments completion(const ProjectGraph& graph,
+                   const std::vector<double>& means,
+                   const std::vector<double>& variances,
+                   int correlationTerms);
+}
+
+#endif // CLARK_APPROXIMATION_H
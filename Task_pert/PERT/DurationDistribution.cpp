@@ -0,0 +1,358 @@
+#include "DurationDistribution.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+constexpr int kBetaIntegrationSteps = 4096;
+constexpr double kLogNormalTail = 1e-9;
+
+// Inverse CDF of Beta(alpha, beta) on [0, 1] sampled at u = j / intervals.
+// The CDF is tabulated by trapezoidal integration of the density and inverted
+// by a monotone walk; alpha, beta >= 1 keeps the density bounded.
+void appendBetaQuantiles(double alpha, double beta, int intervals, std::vector<double>& table)
+{
+    std::vector<double> cdf(kBetaIntegrationSteps + 1, 0.0);
+    auto density = [alpha, beta](double x)
+    {
+        return std::pow(x, alpha - 1.0) * std::pow(1.0 - x, beta - 1.0);
+    };
+
+    const double step = 1.0 / kBetaIntegrationSteps;
+    double previous = density(0.0);
+    for (int i = 1; i <= kBetaIntegrationSteps; ++i)
+    {
+        const double current = density(i * step);
+        cdf[i] = cdf[i - 1] + 0.5 * (previous + current) * step;
+        previous = current;
+    }
+    const double total = cdf.back();
+
+    int cell = 0;
+    for (int j = 0; j <= intervals; ++j)
+    {
+        const double target = total * j / intervals;
+        while (cell < kBetaIntegrationSteps && cdf[cell + 1] < target)
+        {
+            ++cell;
+        }
+        if (cell >= kBetaIntegrationSteps)
+        {
+            table.push_back(1.0);
+            continue;
+        }
+        const double width = cdf[cell + 1] - cdf[cell];
+        const double fraction = width > 0.0 ? (target - cdf[cell]) / width : 0.0;
+        table.push_back(std::min(1.0, (cell + fraction) * step));
+    }
+    table.front() = 0.0;
+    table.back() = 1.0;
+}
+
+// Distribution of graph task `index`: its taskModels entry or the global kind,
+// Empirical without values falling back to Beta-PERT. `model` is set when the
+// task has an entry.
+DistributionKind resolveKind(const ProjectGraph& graph,
+                             int index,
+                             const DistributionSettings& settings,
+                             const DurationModel*& model)
+{
+    DistributionKind kind = settings.kind;
+    model = nullptr;
+    const auto modelIt = settings.taskModels.find(graph.taskId(index));
+    if (modelIt != settings.taskModels.end())
+    {
+        model = &modelIt->second;
+        kind = model->kind;
+    }
+    if (kind == DistributionKind::Empirical && (model == nullptr || model->empiricalValues.empty()))
+    {
+        kind = DistributionKind::BetaPert;
+    }
+    return kind;
+}
+}
+
+DurationMoments durationMoments(const ProjectGraph& graph, const DistributionSettings& settings)
+{
+    const int taskCount = graph.size();
+    const ArrayView<int> optimistic = graph.optimisticTimes();
+    const ArrayView<int> mostLikely = graph.mostLikelyTimes();
+    const ArrayView<int> pessimistic = graph.pessimisticTimes();
+    DurationMoments moments;
+    moments.means.assign(taskCount, 0.0);
+    moments.variances.assign(taskCount, 0.0);
+    moments.lower.assign(taskCount, 0.0);
+    moments.upper.assign(taskCount, 0.0);
+
+    for (int index = 0; index < taskCount; ++index)
+    {
+        const double a = static_cast<double>(optimistic[index]);
+        const double m = static_cast<double>(mostLikely[index]);
+        const double b = static_cast<double>(pessimistic[index]);
+        const double range = b - a;
+        const double peak = range > 0.0 ? std::min(1.0, std::max(0.0, (m - a) / range)) : 0.5;
+        double& mean = moments.means[index];
+        double& variance = moments.variances[index];
+        moments.lower[index] = a;
+        moments.upper[index] = b;
+
+        const DurationModel* model = nullptr;
+        switch (resolveKind(graph, index, settings, model))
+        {
+        case DistributionKind::Uniform:
+            mean = a + range / 2.0;
+            variance = range * range / 12.0;
+            break;
+
+        case DistributionKind::Triangular:
+            mean = a + range * (1.0 + peak) / 3.0;
+            variance = range * range * (1.0 - peak + peak * peak) / 18.0;
+            break;
+
+        case DistributionKind::BetaPert:
+        {
+            const double alpha = 1.0 + 4.0 * peak;
+            const double beta = 1.0 + 4.0 * (1.0 - peak);
+            mean = a + range * alpha / 6.0;
+            variance = range * range * alpha * beta / 252.0; // alpha + beta = 6
+            break;
+        }
+
+        case DistributionKind::LogNormal:
+        {
+            const double deviation = range / 6.0;
+            mean = (a + 4.0 * m + b) / 6.0;
+            if (mean > 0.0 && deviation > 0.0)
+            {
+                variance = deviation * deviation;
+                moments.lower[index] = 0.0;
+                moments.upper[index] = std::numeric_limits<double>::infinity();
+            }
+            else
+            {
+                // Degenerate estimate: sampled as the constant max(0, mean).
+                mean = std::max(0.0, mean);
+                moments.lower[index] = mean;
+                moments.upper[index] = mean;
+            }
+            break;
+        }
+
+        case DistributionKind::Empirical:
+        {
+            const std::vector<double>& values = model->empiricalValues;
+            const std::vector<double>& weights = model->empiricalWeights;
+            const std::size_t size = values.size();
+            double totalWeight = 0.0;
+            for (std::size_t i = 0; weights.size() == size && i < size; ++i)
+            {
+                totalWeight += std::max(0.0, weights[i]);
+            }
+            auto weight = [&](std::size_t i)
+            {
+                return totalWeight > 0.0 ? std::max(0.0, weights[i]) / totalWeight : 1.0 / size;
+            };
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                mean += weight(i) * values[i];
+            }
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                variance += weight(i) * (values[i] - mean) * (values[i] - mean);
+            }
+            moments.lower[index] = *std::min_element(values.begin(), values.end());
+            moments.upper[index] = *std::max_element(values.begin(), values.end());
+            break;
+        }
+        }
+    }
+    return moments;
+}
+
+DurationSampler::DurationSampler(const ProjectGraph& graph,
+                                 const std::vector<int>& order,
+                                 const DistributionSettings& settings)
+    : positionCount_(static_cast<int>(order.size()))
+{
+    const ArrayView<int> optimistic = graph.optimisticTimes();
+    const ArrayView<int> mostLikely = graph.mostLikelyTimes();
+    const ArrayView<int> pessimistic = graph.pessimisticTimes();
+
+    for (int position = 0; position < positionCount_; ++position)
+    {
+        const int index = order[position];
+        const double a = static_cast<double>(optimistic[index]);
+        const double m = static_cast<double>(mostLikely[index]);
+        const double b = static_cast<double>(pessimistic[index]);
+        const double range = b - a;
+        const double peak = range > 0.0 ? std::min(1.0, std::max(0.0, (m - a) / range)) : 0.5;
+
+        const DurationModel* model = nullptr;
+        switch (resolveKind(graph, index, settings, model))
+        {
+        case DistributionKind::Uniform:
+            uniform_.positions.push_back(position);
+            uniform_.indices.push_back(index);
+            uniform_.lower.push_back(a);
+            uniform_.range.push_back(range);
+            break;
+
+        case DistributionKind::Triangular:
+            triangular_.positions.push_back(position);
+            triangular_.indices.push_back(index);
+            triangular_.lower.push_back(a);
+            triangular_.range.push_back(range);
+            triangular_.peak.push_back(peak);
+            break;
+
+        case DistributionKind::BetaPert:
+            betaPert_.positions.push_back(position);
+            betaPert_.indices.push_back(index);
+            betaPert_.lower.push_back(a);
+            betaPert_.range.push_back(range);
+            betaPert_.tableOffsets.push_back(betaTable(peak));
+            break;
+
+        case DistributionKind::LogNormal:
+        {
+            const double mean = (a + 4.0 * m + b) / 6.0;
+            const double deviation = range / 6.0;
+            double sigma = 0.0;
+            double mu = 0.0;
+            if (mean > 0.0 && deviation > 0.0)
+            {
+                const double sigmaSquared = std::log(1.0 + (deviation * deviation) / (mean * mean));
+                sigma = std::sqrt(sigmaSquared);
+                mu = std::log(mean) - 0.5 * sigmaSquared;
+            }
+            if (sigma == 0.0)
+            {
+                // Degenerate estimate: a constant duration is a zero-width uniform.
+                uniform_.positions.push_back(position);
+                uniform_.indices.push_back(index);
+                uniform_.lower.push_back(std::max(0.0, mean));
+                uniform_.range.push_back(0.0);
+                break;
+            }
+            logNormal_.positions.push_back(position);
+            logNormal_.indices.push_back(index);
+            logNormal_.mu.push_back(mu);
+            logNormal_.sigma.push_back(sigma);
+            break;
+        }
+
+        case DistributionKind::Empirical:
+            empirical_.positions.push_back(position);
+            empirical_.indices.push_back(index);
+            empirical_.tableOffsets.push_back(static_cast<int>(aliasProbabilities_.size()));
+            empirical_.tableSizes.push_back(static_cast<int>(model->empiricalValues.size()));
+            addAliasTable(*model);
+            break;
+        }
+    }
+}
+
+int DurationSampler::betaTable(double peak)
+{
+    const int level = static_cast<int>(std::lround(peak * kBetaShapeLevels));
+    const auto it = betaTableOffsets_.find(level);
+    if (it != betaTableOffsets_.end())
+    {
+        return it->second;
+    }
+
+    const double quantizedPeak = static_cast<double>(level) / kBetaShapeLevels;
+    const int offset = static_cast<int>(betaTables_.size());
+    appendBetaQuantiles(1.0 + 4.0 * quantizedPeak, 1.0 + 4.0 * (1.0 - quantizedPeak), kBetaTableIntervals, betaTables_);
+    betaTableOffsets_.emplace(level, offset);
+    return offset;
+}
+
+void DurationSampler::addAliasTable(const DurationModel& model)
+{
+    // Vose's alias method: every column holds its own value with probability p
+    // and the alias value otherwise, so a sample costs one draw and one compare.
+    const std::size_t size = model.empiricalValues.size();
+    std::vector<double> scaled(size, 1.0);
+    if (model.empiricalWeights.size() == size)
+    {
+        double totalWeight = 0.0;
+        for (double weight : model.empiricalWeights)
+        {
+            totalWeight += std::max(0.0, weight);
+        }
+        for (std::size_t i = 0; i < size && totalWeight > 0.0; ++i)
+        {
+            scaled[i] = std::max(0.0, model.empiricalWeights[i]) * size / totalWeight;
+        }
+    }
+
+    const std::size_t offset = aliasProbabilities_.size();
+    aliasProbabilities_.resize(offset + size, 1.0);
+    aliasPrimary_.insert(aliasPrimary_.end(), model.empiricalValues.begin(), model.empiricalValues.end());
+    aliasSecondary_.insert(aliasSecondary_.end(), model.empiricalValues.begin(), model.empiricalValues.end());
+
+    std::vector<std::size_t> small;
+    std::vector<std::size_t> large;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        const std::size_t less = small.back();
+        small.pop_back();
+        const std::size_t more = large.back();
+
+        aliasProbabilities_[offset + less] = scaled[less];
+        aliasSecondary_[offset + less] = model.empiricalValues[more];
+
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    // Whatever is left (rounding) keeps its own value with probability one.
+}
+
+void DurationSampler::bounds(std::vector<double>& lower, std::vector<double>& upper) const
+{
+    lower.assign(positionCount_, 0.0);
+    upper.assign(positionCount_, 0.0);
+
+    for (std::size_t k = 0; k < uniform_.positions.size(); ++k)
+    {
+        lower[uniform_.positions[k]] = uniform_.lower[k];
+        upper[uniform_.positions[k]] = uniform_.lower[k] + uniform_.range[k];
+    }
+    for (std::size_t k = 0; k < triangular_.positions.size(); ++k)
+    {
+        lower[triangular_.positions[k]] = triangular_.lower[k];
+        upper[triangular_.positions[k]] = triangular_.lower[k] + triangular_.range[k];
+    }
+    for (std::size_t k = 0; k < betaPert_.positions.size(); ++k)
+    {
+        lower[betaPert_.positions[k]] = betaPert_.lower[k];
+        upper[betaPert_.positions[k]] = betaPert_.lower[k] + betaPert_.range[k];
+    }
+    for (std::size_t k = 0; k < logNormal_.positions.size(); ++k)
+    {
+        const double mu = logNormal_.mu[k];
+        const double sigma = logNormal_.sigma[k];
+        lower[logNormal_.positions[k]] = std::exp(mu + sigma * standardNormalQuantile(kLogNormalTail));
+        upper[logNormal_.positions[k]] = std::exp(mu + sigma * standardNormalQuantile(1.0 - kLogNormalTail));
+    }
+    for (std::size_t k = 0; k < empirical_.positions.size(); ++k)
+    {
+        const auto first = aliasPrimary_.begin() + empirical_.tableOffsets[k];
+        const auto last = first + empirical_.tableSizes[k];
+        lower[empirical_.positions[k]] = *std::min_element(first, last);
+        upper[empirical_.positions[k]] = *std::max_element(first, last);
+    }
+}
@@ -0,0 +1,208 @@
+#ifndef DURATION_DISTRIBUTION_H
+#define DURATION_DISTRIBUTION_H
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "NormalDistribution.h"
+#include "ProjectGraph.h"
+
+// Task duration models available to the simulation. Every model is sampled by
+// inverse CDF from one uniform draw, so all of them share the same random streams.
+enum class DistributionKind
+{
+    Uniform,    // flat between optimistic and pessimistic time
+    Triangular, // optimistic / most likely / pessimistic as min / mode / max
+    BetaPert,   // Beta with alpha = 1 + 4(m - a)/(b - a), beta = 1 + 4(b - m)/(b - a) on [a, b]
+    LogNormal,  // matches the PERT mean (a + 4m + b)/6 and standard deviation (b - a)/6
+    Empirical   // observed durations (optionally weighted), sampled with an alias table
+};
+
+// Per-task override of the global distribution.
+struct DurationModel
+{
+    DistributionKind kind = DistributionKind::BetaPert;
+    std::vector<double> empiricalValues;  // Empirical only
+    std::vector<double> empiricalWeights; // Empirical only; equal weights when empty
+};
+
+struct DistributionSettings
+{
+    DistributionKind kind = DistributionKind::Uniform;
+    std::map<int, DurationModel> taskModels; // keyed by task id
+};
+
+// Mean, variance and support of every task's duration (indexed like the
+// graph) under DistributionSettings, resolved per task as DurationSampler
+// does, before the sampled durations are rounded to whole units.
+struct DurationMoments
+{
+    std::vector<double> means;
+    std::vector<double> variances;
+    std::vector<double> lower;
+    std::vector<double> upper; // +inf for LogNormal
+};
+
+DurationMoments durationMoments(const ProjectGraph& graph, const DistributionSettings& settings);
+
+// Half-away-from-zero rounding like std::round, but inlined so the sampling loops vectorize.
+inline int roundToUnit(double value)
+{
+    return static_cast<int>(value + (value < 0.0 ? -0.5 : 0.5));
+}
+
+// Turns uniform draws into rounded task durations. Tasks are grouped by
+// distribution kind at construction and each group is sampled by its own
+// tight loop, so the kind is resolved at compile time rather than per draw.
+// Beta-PERT uses precomputed inverse-CDF tables (shared between tasks with the
+// same shape), empirical models use Vose alias tables.
+class DurationSampler
+{
+public:
+    DurationSampler() = default;
+
+    // `order` maps the sampler's positions to graph indices. Tasks with an
+    // Empirical model but no values fall back to Beta-PERT.
+    DurationSampler(const ProjectGraph& graph,
+                    const std::vector<int>& order,
+                    const DistributionSettings& settings);
+
+    // Writes Lanes durations per position (position-major) to `durations`.
+    // `unit(lane, index)` returns the uniform draw in [0, 1) of graph task `index` for `lane`.
+    template <int Lanes, typename UnitSource>
+    void sample(const UnitSource& unit, int* durations) const;
+
+    // Smallest and largest duration each position can take (far quantiles for LogNormal).
+    void bounds(std::vector<double>& lower, std::vector<double>& upper) const;
+
+private:
+    static constexpr int kBetaTableIntervals = 256;
+    static constexpr int kBetaShapeLevels = 1024; // mode position quantized to 1/1024 of the range
+
+    struct LinearGroup // Uniform
+    {
+        std::vector<int> positions, indices;
+        std::vector<double> lower, range;
+    };
+
+    struct TriangularGroup
+    {
+        std::vector<int> positions, indices;
+        std::vector<double> lower, range, peak; // peak = (m - a) / (b - a)
+    };
+
+    struct TableGroup // BetaPert
+    {
+        std::vector<int> positions, indices;
+        std::vector<double> lower, range;
+        std::vector<int> tableOffsets; // into betaTables_
+    };
+
+    struct LogNormalGroup
+    {
+        std::vector<int> positions, indices;
+        std::vector<double> mu, sigma;
+    };
+
+    struct AliasGroup // Empirical
+    {
+        std::vector<int> positions, indices;
+        std::vector<int> tableOffsets, tableSizes; // into alias arrays
+    };
+
+    int betaTable(double peak);
+    void addAliasTable(const DurationModel& model);
+
+    LinearGroup uniform_;
+    TriangularGroup triangular_;
+    TableGroup betaPert_;
+    LogNormalGroup logNormal_;
+    AliasGroup empirical_;
+
+    std::vector<double> betaTables_;           // kBetaTableIntervals + 1 quantiles per shape
+    std::map<int, int> betaTableOffsets_;      // quantized peak -> offset
+    std::vector<double> aliasProbabilities_;
+    std::vector<double> aliasPrimary_;
+    std::vector<double> aliasSecondary_;
+    int positionCount_ = 0;
+};
+
+template <int Lanes, typename UnitSource>
+void DurationSampler::sample(const UnitSource& unit, int* durations) const
+{
+    for (std::size_t k = 0; k < uniform_.positions.size(); ++k)
+    {
+        int* target = durations + static_cast<std::size_t>(uniform_.positions[k]) * Lanes;
+        const int index = uniform_.indices[k];
+        const double lower = uniform_.lower[k];
+        const double range = uniform_.range[k];
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            target[lane] = roundToUnit(lower + range * unit(lane, index));
+        }
+    }
+
+    for (std::size_t k = 0; k < triangular_.positions.size(); ++k)
+    {
+        int* target = durations + static_cast<std::size_t>(triangular_.positions[k]) * Lanes;
+        const int index = triangular_.indices[k];
+        const double lower = triangular_.lower[k];
+        const double range = triangular_.range[k];
+        const double peak = triangular_.peak[k];
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            const double u = unit(lane, index);
+            const double x = u < peak ? std::sqrt(u * peak) : 1.0 - std::sqrt((1.0 - u) * (1.0 - peak));
+            target[lane] = roundToUnit(lower + range * x);
+        }
+    }
+
+    for (std::size_t k = 0; k < betaPert_.positions.size(); ++k)
+    {
+        int* target = durations + static_cast<std::size_t>(betaPert_.positions[k]) * Lanes;
+        const int index = betaPert_.indices[k];
+        const double lower = betaPert_.lower[k];
+        const double range = betaPert_.range[k];
+        const double* table = betaTables_.data() + betaPert_.tableOffsets[k];
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            const double scaled = unit(lane, index) * kBetaTableIntervals;
+            const int cell = static_cast<int>(scaled);
+            const double fraction = scaled - cell;
+            const double x = table[cell] + (table[cell + 1] - table[cell]) * fraction;
+            target[lane] = roundToUnit(lower + range * x);
+        }
+    }
+
+    for (std::size_t k = 0; k < logNormal_.positions.size(); ++k)
+    {
+        int* target = durations + static_cast<std::size_t>(logNormal_.positions[k]) * Lanes;
+        const int index = logNormal_.indices[k];
+        const double mu = logNormal_.mu[k];
+        const double sigma = logNormal_.sigma[k];
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            target[lane] = roundToUnit(std::exp(mu + sigma * standardNormalQuantile(unit(lane, index))));
+        }
+    }
+
+    for (std::size_t k = 0; k < empirical_.positions.size(); ++k)
+    {
+        int* target = durations + static_cast<std::size_t>(empirical_.positions[k]) * Lanes;
+        const int index = empirical_.indices[k];
+        const int offset = empirical_.tableOffsets[k];
+        const int size = empirical_.tableSizes[k];
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            // One draw picks the column (integer part) and the coin (fractional part).
+            const double scaled = unit(lane, index) * size;
+            const int column = offset + static_cast<int>(scaled);
+            const double coin = scaled - static_cast<int>(scaled);
+            target[lane] = roundToUnit(coin < aliasProbabilities_[column] ? aliasPrimary_[column]
+                                                                          : aliasSecondary_[column]);
+        }
+    }
+}
+
+#endif // DURATION_DISTRIBUTION_H
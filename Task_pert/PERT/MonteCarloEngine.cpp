@@ -0,0 +1,424 @@
+#include "MonteCarloEngine.h"
+#include "LongestPath.h"
+#include "RandomStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+constexpr std::uint64_t kTieBreakStream = 0x5449454252454B53ULL;
+
+// Tie-break stream of a sample: one draw per predecessor edge, then one per sink.
+RandomStream tieBreakStream(std::uint64_t seed, std::uint64_t sampleIndex)
+{
+    return RandomStream(seed ^ kTieBreakStream, sampleIndex);
+}
+
+// Reservoir step over the predecessors with the latest finish: the `ties`-th
+// of them replaces the current choice with probability 1 / ties, so each one
+// ends up chosen with equal probability.
+inline bool takesTie(const RandomStream& stream, std::uint64_t counter, int ties)
+{
+    return stream.unitAt(counter) * ties < 1.0;
+}
+
+// Vertical operations on kLaneCount packed 32-bit finish times.
+#if defined(__AVX512F__)
+struct Lanes
+{
+    using Vector = __m512i;
+    static Vector zero() { return _mm512_setzero_si512(); }
+    static Vector load(const int* source) { return _mm512_loadu_si512(source); }
+    static void store(int* target, Vector value) { _mm512_storeu_si512(target, value); }
+    static Vector max(Vector lhs, Vector rhs) { return _mm512_max_epi32(lhs, rhs); }
+    static Vector add(Vector lhs, Vector rhs) { return _mm512_add_epi32(lhs, rhs); }
+};
+#elif defined(__AVX2__)
+struct Lanes
+{
+    using Vector = __m256i;
+    static Vector zero() { return _mm256_setzero_si256(); }
+    static Vector load(const int* source) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)); }
+    static void store(int* target, Vector value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(target), value); }
+    static Vector max(Vector lhs, Vector rhs) { return _mm256_max_epi32(lhs, rhs); }
+    static Vector add(Vector lhs, Vector rhs) { return _mm256_add_epi32(lhs, rhs); }
+};
+#else
+struct Lanes
+{
+    struct Vector
+    {
+        int values[MonteCarloEngine::kLaneCount];
+    };
+
+    static Vector zero() { return Vector{}; }
+
+    static Vector load(const int* source)
+    {
+        Vector result;
+        std::copy(source, source + MonteCarloEngine::kLaneCount, result.values);
+        return result;
+    }
+
+    static void store(int* target, const Vector& value)
+    {
+        std::copy(value.values, value.values + MonteCarloEngine::kLaneCount, target);
+    }
+
+    static Vector max(const Vector& lhs, const Vector& rhs)
+    {
+        Vector result;
+        for (int lane = 0; lane < MonteCarloEngine::kLaneCount; ++lane)
+        {
+            result.values[lane] = std::max(lhs.values[lane], rhs.values[lane]);
+        }
+        return result;
+    }
+
+    static Vector add(const Vector& lhs, const Vector& rhs)
+    {
+        Vector result;
+        for (int lane = 0; lane < MonteCarloEngine::kLaneCount; ++lane)
+        {
+            result.values[lane] = lhs.values[lane] + rhs.values[lane];
+        }
+        return result;
+    }
+};
+#endif
+}
+
+MonteCarloEngine::MonteCarloEngine(const ProjectGraph& graph,
+                                   const DistributionSettings& distributions,
+                                   SamplingScheme sampling)
+    : sequence_(sampling, graph), graphSize_(graph.size())
+{
+    const ArrayView<int> topoOrder = graph.topologicalOrder();
+    const int positions = static_cast<int>(topoOrder.size());
+
+    order_.assign(topoOrder.begin(), topoOrder.end());
+
+    // Tasks on a cycle never enter the topological order and are skipped, as in CPMCalculator.
+    std::vector<int> positionOf(graph.size(), -1);
+    for (int position = 0; position < positions; ++position)
+    {
+        positionOf[order_[position]] = position;
+    }
+
+    predecessorOffsets_.assign(positions + 1, 0);
+    predecessorPositions_.clear();
+    predecessorPositions_.reserve(graph.edgeCount());
+    sinkPositions_.clear();
+
+    for (int position = 0; position < positions; ++position)
+    {
+        const int index = order_[position];
+        for (int predecessor : graph.predecessors(index))
+        {
+            predecessorPositions_.push_back(positionOf[predecessor]);
+        }
+        predecessorOffsets_[position + 1] = static_cast<int>(predecessorPositions_.size());
+
+        if (graph.isSink(index))
+        {
+            sinkPositions_.push_back(position);
+        }
+    }
+
+    sampler_ = DurationSampler(graph, order_, distributions);
+}
+
+MonteCarloEngine::Workspace MonteCarloEngine::makeWorkspace() const
+{
+    Workspace workspace;
+    workspace.durations.assign(taskCount(), 0);
+    workspace.finishTimes.assign(taskCount(), 0);
+    workspace.laneDurations.assign(static_cast<std::size_t>(taskCount()) * kLaneCount, 0);
+    workspace.laneFinishTimes.assign(static_cast<std::size_t>(taskCount()) * kLaneCount, 0);
+    workspace.criticalParents.assign(taskCount(), -1);
+    workspace.laneCriticalParents.assign(static_cast<std::size_t>(taskCount()) * kLaneCount, -1);
+    workspace.logUnits.assign(graphSize_, 0.0);
+    return workspace;
+}
+
+int MonteCarloEngine::minCompletionTime() const
+{
+    std::vector<double> lower;
+    std::vector<double> upper;
+    sampler_.bounds(lower, upper);
+    return boundingCompletionTime(lower);
+}
+
+int MonteCarloEngine::maxCompletionTime() const
+{
+    std::vector<double> lower;
+    std::vector<double> upper;
+    sampler_.bounds(lower, upper);
+    return boundingCompletionTime(upper);
+}
+
+int MonteCarloEngine::boundingCompletionTime(const std::vector<double>& durations) const
+{
+    Workspace workspace = makeWorkspace();
+    for (std::size_t position = 0; position < durations.size(); ++position)
+    {
+        workspace.durations[position] = roundToUnit(durations[position]);
+    }
+    return forwardPass<false>(workspace);
+}
+
+CriticalityStatistics MonteCarloEngine::makeCriticalityStatistics() const
+{
+    std::vector<double> lower;
+    std::vector<double> upper;
+    sampler_.bounds(lower, upper);
+
+    std::vector<double> middle(lower.size());
+    std::vector<int> references(lower.size());
+    for (std::size_t position = 0; position < lower.size(); ++position)
+    {
+        middle[position] = 0.5 * (lower[position] + upper[position]);
+        references[position] = roundToUnit(middle[position]);
+    }
+    return CriticalityStatistics(std::move(references), boundingCompletionTime(middle));
+}
+
+int MonteCarloEngine::sample(Workspace& workspace,
+                             std::uint64_t seed,
+                             std::uint64_t sampleIndex,
+                             CriticalityStatistics* criticality) const
+{
+    // Durations are rounded to whole time units like the CPM durations.
+    const RandomStream stream = sequence_.stream(seed, sampleIndex);
+    if (sequence_.scheme() == SamplingScheme::Random)
+    {
+        sampler_.sample<1>([&stream](int, int index) { return stream.unitAt(index); },
+                           workspace.durations.data());
+    }
+    else
+    {
+        sampler_.sample<1>([&](int, int index) { return sequence_.unit(stream, seed, sampleIndex, index); },
+                           workspace.durations.data());
+    }
+
+    if (criticality == nullptr)
+    {
+        return forwardPass<false>(workspace);
+    }
+
+    const RandomStream ties = tieBreakStream(seed, sampleIndex);
+    const int completion = forwardPass<true>(workspace, &ties);
+    criticality->addSamples(workspace.durations.data(), 1, &completion, 1);
+    addCriticalChain(workspace.criticalParents.data(), workspace.finishTimes.data(), 1, completion, ties,
+                     *criticality);
+    return completion;
+}
+
+int MonteCarloEngine::sampleTilted(Workspace& workspace,
+                                   std::uint64_t seed,
+                                   std::uint64_t sampleIndex,
+                                   const std::vector<double>& tilts,
+                                   double& logLikelihoodRatio) const
+{
+    const RandomStream stream(seed, sampleIndex);
+    double* logUnits = workspace.logUnits.data();
+    double logRatio = 0.0;
+
+    sampler_.sample<1>(
+        [&](int, int index)
+        {
+            // Midpoint of the 2^-53 cell keeps log v finite.
+            const double tilt = tilts[index];
+            const double logUnit = std::log(stream.unitAt(index) + 0x1.0p-54) / tilt;
+            logUnits[index] = logUnit;
+            logRatio -= std::log(tilt) + (tilt - 1.0) * logUnit;
+            return std::min(std::exp(logUnit), 1.0 - 0x1.0p-53);
+        },
+        workspace.durations.data());
+
+    logLikelihoodRatio = logRatio;
+    return forwardPass<false>(workspace);
+}
+
+template <bool TrackParents>
+int MonteCarloEngine::forwardPass(Workspace& workspace, const RandomStream* ties) const
+{
+    const int positions = taskCount();
+    const int* offsets = predecessorOffsets_.data();
+    const int* predecessors = predecessorPositions_.data();
+    const int* durations = workspace.durations.data();
+    int* finish = workspace.finishTimes.data();
+    int* parents = workspace.criticalParents.data();
+
+    if constexpr (TrackParents)
+    {
+        for (int position = 0; position < positions; ++position)
+        {
+            // Same choice as forwardPassBatch makes for the lane of this sample.
+            int start = 0;
+            int parent = -1;
+            int tied = 0;
+            for (int edge = offsets[position]; edge < offsets[position + 1]; ++edge)
+            {
+                const int predecessorFinish = finish[predecessors[edge]];
+                if (parent < 0 || predecessorFinish > start)
+                {
+                    start = predecessorFinish;
+                    parent = predecessors[edge];
+                    tied = 1;
+                }
+                else if (predecessorFinish == start && takesTie(*ties, edge, ++tied))
+                {
+                    parent = predecessors[edge];
+                }
+            }
+            parents[position] = parent;
+            finish[position] = start + durations[position];
+        }
+    }
+    else
+    {
+        LongestPath::forwardPass<LongestPath::Output::Total, int>(LongestPath::Positions{}, positions, offsets,
+                                                                  predecessors, durations, nullptr, finish);
+    }
+
+    return LongestPath::completionTime(finish, sinkPositions_.data(), static_cast<int>(sinkPositions_.size()));
+}
+
+void MonteCarloEngine::addCriticalChain(const int* parents,
+                                        const int* finish,
+                                        int stride,
+                                        int completion,
+                                        const RandomStream& ties,
+                                        CriticalityStatistics& criticality) const
+{
+    // Sink draws follow the edge draws in the tie-break stream.
+    const std::uint64_t firstCounter = predecessorPositions_.size();
+    int position = -1;
+    int tied = 0;
+    for (std::size_t k = 0; k < sinkPositions_.size(); ++k)
+    {
+        const int sink = sinkPositions_[k];
+        if (finish[static_cast<std::size_t>(sink) * stride] == completion &&
+            (tied++ == 0 || takesTie(ties, firstCounter + k, tied)))
+        {
+            position = sink;
+        }
+    }
+
+    while (position >= 0)
+    {
+        criticality.addCritical(position);
+        position = parents[static_cast<std::size_t>(position) * stride];
+    }
+}
+
+void MonteCarloEngine::sampleBatch(Workspace& workspace,
+                                   std::uint64_t seed,
+                                   std::uint64_t firstSample,
+                                   int* completionTimes,
+                                   CriticalityStatistics* criticality,
+                                   int criticalLanes) const
+{
+    // Each lane draws from the streams of its own sample, exactly like sample().
+    RandomStream streams[kLaneCount];
+    RandomStream ties[kLaneCount];
+    for (int lane = 0; lane < kLaneCount; ++lane)
+    {
+        streams[lane] = sequence_.stream(seed, firstSample + lane);
+        ties[lane] = tieBreakStream(seed, firstSample + lane);
+    }
+
+    if (sequence_.scheme() == SamplingScheme::Random)
+    {
+        sampler_.sample<kLaneCount>([&streams](int lane, int index) { return streams[lane].unitAt(index); },
+                                    workspace.laneDurations.data());
+    }
+    else
+    {
+        sampler_.sample<kLaneCount>(
+            [&](int lane, int index) { return sequence_.unit(streams[lane], seed, firstSample + lane, index); },
+            workspace.laneDurations.data());
+    }
+
+    if (criticality == nullptr)
+    {
+        forwardPassBatch<false>(workspace, completionTimes);
+        return;
+    }
+
+    forwardPassBatch<true>(workspace, completionTimes, ties);
+    criticality->addSamples(workspace.laneDurations.data(), kLaneCount, completionTimes, criticalLanes);
+    for (int lane = 0; lane < criticalLanes; ++lane)
+    {
+        addCriticalChain(workspace.laneCriticalParents.data() + lane, workspace.laneFinishTimes.data() + lane,
+                         kLaneCount, completionTimes[lane], ties[lane], *criticality);
+    }
+}
+
+template <bool TrackParents>
+void MonteCarloEngine::forwardPassBatch(Workspace& workspace, int* completionTimes, const RandomStream* ties) const
+{
+    const int positions = taskCount();
+    const int* offsets = predecessorOffsets_.data();
+    const int* predecessors = predecessorPositions_.data();
+    const int* durations = workspace.laneDurations.data();
+    int* finish = workspace.laneFinishTimes.data();
+    int* parents = workspace.laneCriticalParents.data();
+
+    for (int position = 0; position < positions; ++position)
+    {
+        const std::size_t offset = static_cast<std::size_t>(position) * kLaneCount;
+        Lanes::Vector start = Lanes::zero();
+        if constexpr (TrackParents)
+        {
+            // The start is one vertical max per predecessor; the parent, a
+            // random one of the predecessors finishing at the start, is then
+            // picked per lane like forwardPass does.
+            for (int edge = offsets[position]; edge < offsets[position + 1]; ++edge)
+            {
+                const std::size_t predecessor = static_cast<std::size_t>(predecessors[edge]);
+                start = Lanes::max(start, Lanes::load(finish + predecessor * kLaneCount));
+            }
+            alignas(64) int starts[kLaneCount];
+            Lanes::store(starts, start);
+            for (int lane = 0; lane < kLaneCount; ++lane)
+            {
+                int parent = -1;
+                int tied = 0;
+                for (int edge = offsets[position]; edge < offsets[position + 1]; ++edge)
+                {
+                    const std::size_t predecessor = static_cast<std::size_t>(predecessors[edge]);
+                    if (finish[predecessor * kLaneCount + lane] == starts[lane] &&
+                        (tied++ == 0 || takesTie(ties[lane], edge, tied)))
+                    {
+                        parent = predecessors[edge];
+                    }
+                }
+                parents[offset + lane] = parent;
+            }
+        }
+        else
+        {
+            for (int edge = offsets[position]; edge < offsets[position + 1]; ++edge)
+            {
+                const std::size_t predecessor = static_cast<std::size_t>(predecessors[edge]);
+                start = Lanes::max(start, Lanes::load(finish + predecessor * kLaneCount));
+            }
+        }
+        Lanes::store(finish + offset, Lanes::add(start, Lanes::load(durations + offset)));
+    }
+
+    Lanes::Vector completion = Lanes::zero();
+    for (int position : sinkPositions_)
+    {
+        completion = Lanes::max(completion, Lanes::load(finish + static_cast<std::size_t>(position) * kLaneCount));
+    }
+    Lanes::store(completionTimes, completion);
+}
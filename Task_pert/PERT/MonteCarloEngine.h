@@ -0,0 +1,124 @@
+#ifndef MONTE_CARLO_ENGINE_H
+#define MONTE_CARLO_ENGINE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "DurationDistribution.h"
+#include "ProjectGraph.h"
+#include "SampleSequence.h"
+#include "SimulationStatistics.h"
+
+// Forward-only longest-path pass for PERT simulation. The topology is
+// flattened once into topological positions so every sample is a single
+// allocation-free sweep over contiguous arrays (LongestPath::forwardPass with
+// Output::Total, or the lane-batched and parent-tracking variants below). The engine itself is
+// immutable; each thread brings its own Workspace.
+//
+// sampleBatch() runs kLaneCount samples through one sweep: every task holds a
+// vector of per-sample finish times and the pass is a sequence of vertical
+// max/add instructions (AVX-512 or AVX2 when enabled at compile time, plain
+// loops otherwise). Batched and single samples produce identical values.
+//
+// With a CriticalityStatistics tally the pass also keeps, per task, the
+// predecessor that determined its start and walks those links back from the
+// latest sink, so the critical chain of every sample is found without extra
+// passes or allocation. Integer durations make equal finishes common, so a
+// tie between predecessors (or sinks) is broken uniformly at random with
+// draws from the sample's own tie-break stream: no task is favoured by its
+// position, and the result stays the same for any thread count or batching.
+class MonteCarloEngine
+{
+public:
+#if defined(__AVX512F__)
+    static constexpr int kLaneCount = 16;
+#else
+    static constexpr int kLaneCount = 8;
+#endif
+
+    struct Workspace
+    {
+        std::vector<int> durations;   // sampled duration per topological position
+        std::vector<int> finishTimes;
+        std::vector<int> laneDurations;   // kLaneCount samples per position, sample-minor
+        std::vector<int> laneFinishTimes;
+        std::vector<int> criticalParents;      // deciding predecessor position, -1 for sources
+        std::vector<int> laneCriticalParents;
+        std::vector<double> logUnits;          // log u per graph index (sampleTilted)
+    };
+
+    explicit MonteCarloEngine(const ProjectGraph& graph,
+                              const DistributionSettings& distributions = DistributionSettings(),
+                              SamplingScheme sampling = SamplingScheme::Random);
+
+    int taskCount() const { return static_cast<int>(order_.size()); }
+    int graphIndex(int position) const { return order_[position]; }
+    int graphSize() const { return graphSize_; }
+
+    Workspace makeWorkspace() const;
+
+    // Smallest and largest completion time any sample can produce (all tasks at
+    // the bottom / top of their distribution).
+    int minCompletionTime() const;
+    int maxCompletionTime() const;
+
+    // Empty tally over the topological positions, referenced to the mid-range durations.
+    CriticalityStatistics makeCriticalityStatistics() const;
+
+    // Draws the durations of sample `sampleIndex` (under the engine's sampling
+    // scheme, from the counter-based streams of `seed`) and returns the project
+    // completion time. Deterministic per (seed, sampleIndex).
+    // The sample is added to `criticality` when one is given.
+    int sample(Workspace& workspace,
+               std::uint64_t seed,
+               std::uint64_t sampleIndex,
+               CriticalityStatistics* criticality = nullptr) const;
+
+    // Runs samples firstSample .. firstSample + kLaneCount - 1 at once and writes
+    // their completion times to completionTimes[0 .. kLaneCount - 1]. Only the
+    // first `criticalLanes` samples are added to `criticality`.
+    void sampleBatch(Workspace& workspace,
+                     std::uint64_t seed,
+                     std::uint64_t firstSample,
+                     int* completionTimes,
+                     CriticalityStatistics* criticality = nullptr,
+                     int criticalLanes = kLaneCount) const;
+
+    // Importance-sampling draw: task `index` takes u = v^(1 / tilts[index]) with v
+    // from the pseudo-random stream of the sample, i.e. u ~ Beta(tilt, 1), which
+    // favours long durations for tilt > 1. Returns the completion time; the log
+    // of the likelihood ratio (uniform over tilted density) of the whole sample
+    // goes to logLikelihoodRatio and log u of every task to workspace.logUnits.
+    int sampleTilted(Workspace& workspace,
+                     std::uint64_t seed,
+                     std::uint64_t sampleIndex,
+                     const std::vector<double>& tilts,
+                     double& logLikelihoodRatio) const;
+
+private:
+    int boundingCompletionTime(const std::vector<double>& durations) const;
+
+    // `ties` (TrackParents only) is the tie-break stream of the sample.
+    template <bool TrackParents>
+    int forwardPass(Workspace& workspace, const RandomStream* ties = nullptr) const;
+
+    // `ties` (TrackParents only) holds the tie-break stream of every lane.
+    template <bool TrackParents>
+    void forwardPassBatch(Workspace& workspace, int* completionTimes, const RandomStream* ties = nullptr) const;
+
+    // Adds the critical chain ending at a latest sink (chosen with `ties`);
+    // parents/finish are `stride` ints apart per position.
+    void addCriticalChain(const int* parents, const int* finish, int stride, int completion,
+                          const RandomStream& ties, CriticalityStatistics& criticality) const;
+
+    std::vector<int> order_;                // topological position -> graph index
+    std::vector<int> predecessorOffsets_;   // CSR over topological positions
+    std::vector<int> predecessorPositions_;
+    std::vector<int> sinkPositions_;
+
+    DurationSampler sampler_;
+    SampleSequence sequence_;
+    int graphSize_ = 0;
+};
+
+#endif // MONTE_CARLO_ENGINE_H
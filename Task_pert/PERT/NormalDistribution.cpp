@@ -0,0 +1,74 @@
+#include "NormalDistribution.h"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Acklam's coefficients: a / b for the central region, c / d for the tails.
+constexpr double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                        1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+constexpr double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                        6.680131188771972e+01, -1.328068155288572e+01};
+constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                        -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+constexpr double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                        3.754408661907416e+00};
+constexpr double kLowRegion = 0.02425;
+
+inline bool isCentral(double p)
+{
+    return p >= kLowRegion && p <= 1.0 - kLowRegion;
+}
+
+inline double centralQuantile(double p)
+{
+    const double q = p - 0.5;
+    const double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+double tailQuantile(double p)
+{
+    if (p <= 0.0)
+    {
+        return -std::numeric_limits<double>::infinity();
+    }
+    if (p >= 1.0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    const bool lower = p < kLowRegion;
+    const double q = std::sqrt(-2.0 * std::log(lower ? p : 1.0 - p));
+    const double z = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                     ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    return lower ? z : -z;
+}
+}
+
+double standardNormalCDF(double z)
+{
+    return 0.5 * std::erfc(-z / std::sqrt(2.0));
+}
+
+double standardNormalQuantile(double p)
+{
+    return isCentral(p) ? centralQuantile(p) : tailQuantile(p);
+}
+
+void standardNormalQuantiles(const double* probabilities, double* quantiles, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        quantiles[i] = centralQuantile(probabilities[i]);
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        if (!isCentral(probabilities[i]))
+        {
+            quantiles[i] = tailQuantile(probabilities[i]);
+        }
+    }
+}
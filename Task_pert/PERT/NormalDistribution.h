@@ -0,0 +1,20 @@
+#ifndef NORMAL_DISTRIBUTION_H
+#define NORMAL_DISTRIBUTION_H
+
+// Standard normal distribution for the analytic PERT figures, the simulation's
+// confidence intervals and the log-normal duration model.
+
+// P(Z <= z).
+double standardNormalCDF(double z);
+
+// Inverse of standardNormalCDF by Acklam's rational approximation (relative
+// error < 1.2e-9 over the whole range); -inf / +inf outside (0, 1).
+double standardNormalQuantile(double p);
+
+// standardNormalQuantile of `count` probabilities. The central region, where
+// almost all probabilities of interest fall, is evaluated for the whole batch
+// in one branch-free loop the compiler can vectorize; only the tails take
+// the logarithm path afterwards. Gives the same values as the scalar call.
+void standardNormalQuantiles(const double* probabilities, double* quantiles, int count);
+
+#endif // NORMAL_DISTRIBUTION_H
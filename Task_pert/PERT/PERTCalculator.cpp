@@ -1,247 +1,865 @@
 #include "PERTCalculator.h"
-#include "../CPM/CPMCalculator.h"
+#include "ClarkApproximation.h"
+#include "LevelScheduler.h"
+#include "LongestPath.h"
+#include "MonteCarloEngine.h"
+#include "NormalDistribution.h"
+
+#include "RandomStream.h"
+#include "SimulationStatistics.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
-#include <functional>
 #include <limits>
 #include <random>
-#include <numeric>
+#include <thread>
 
 namespace
 {
-constexpr double kSlackTolerance = 1e-6;
+constexpr int kSimulationBlockSize = 4096;
+constexpr double kMaxTilt = 1000.0;
+constexpr std::uint64_t kTuningStream = 0x43524F5353454E54ULL;
+constexpr double kClarkClipTolerance = 1e-3;
 
-void initializeStartTimes(std::map<int, Task_pert>& tasks,
-                          std::map<int, int>& inDegree,
-                          std::vector<int>& topoOrder)
+std::uint64_t drawSeed()
 {
-    topoOrder.clear();
-    inDegree.clear();
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+}
 
-    for (auto& [id, task] : tasks)
+// Completion time with every task taking `durations` (indexed like the graph).
+double completionWith(const ProjectGraph& graph, const std::vector<double>& durations)
+{
+    ProjectSchedule<double> schedule;
+    schedule.reset(graph.size());
+    return LongestPath::computeSchedule<LongestPath::Output::Total>(graph, ArrayView<double>(durations), schedule);
+}
+
+// The support in whole units, as the engine samples: every duration is rounded.
+std::vector<double> roundedDurations(std::vector<double> durations)
+{
+    for (double& duration : durations)
+    {
+        duration = std::round(duration);
+    }
+    return durations;
+}
+
+double percentileIndex(double percentile, std::size_t count)
+{
+    return (percentile / 100.0) * (count - 1);
+}
+
+// Linear interpolation between the order statistics around the percentile;
+// only those two positions of `orderedTimes` have to be in sorted position.
+double interpolatePercentile(const std::vector<double>& orderedTimes, double percentile)
+{
+    const double index = percentileIndex(percentile, orderedTimes.size());
+    const std::size_t lowerIndex = static_cast<std::size_t>(std::floor(index));
+    const std::size_t upperIndex = static_cast<std::size_t>(std::ceil(index));
+
+    if (lowerIndex == upperIndex)
+    {
+        return orderedTimes[lowerIndex];
+    }
+
+    const double weight = index - lowerIndex;
+    return orderedTimes[lowerIndex] * (1.0 - weight) + orderedTimes[upperIndex] * weight;
+}
+
+// Moves the order statistics with the given ascending ranks into their sorted
+// positions (rank r of [first, last) lives at first + r - offset), in O(n log k).
+void selectRanks(std::vector<double>::iterator first,
+                 std::vector<double>::iterator last,
+                 std::size_t offset,
+                 const std::size_t* ranksBegin,
+                 const std::size_t* ranksEnd)
+{
+    if (ranksBegin == ranksEnd || first == last)
+    {
+        return;
+    }
+
+    const std::size_t* middle = ranksBegin + (ranksEnd - ranksBegin) / 2;
+    const auto nth = first + static_cast<std::ptrdiff_t>(*middle - offset);
+    std::nth_element(first, nth, last);
+    selectRanks(first, nth, offset, ranksBegin, middle);
+    selectRanks(nth + 1, last, *middle + 1, middle + 1, ranksEnd);
+}
+
+double countWithin(const std::vector<double>& sortedTimes, double time)
+{
+    const auto end = std::upper_bound(sortedTimes.begin(), sortedTimes.end(), time);
+    return static_cast<double>(end - sortedTimes.begin()) / sortedTimes.size();
+}
+
+int resolveThreadCount(int requested, int blockCount)
+{
+    int threads = requested > 0 ? requested : static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(threads, blockCount));
+}
+
+// Confidence-interval half-width of the stopping statistic over the samples in
+// `simulation`; the point estimate goes to `estimate`. Percentiles use the
+// distribution-free interval between the order statistics at q -/+ z sqrt(q(1-q)/n).
+double confidenceHalfWidth(const PERTSimulation& simulation, const StoppingRule& rule, double& estimate)
+{
+    const double n = static_cast<double>(simulation.simulations);
+    const double z = standardNormalQuantile(0.5 + 0.5 * rule.confidence);
+
+    switch (rule.target)
+    {
+    case StoppingTarget::Mean:
+        estimate = simulation.meanDuration;
+        return z * simulation.standardDeviation / std::sqrt(n);
+
+    case StoppingTarget::Probability:
     {
-        inDegree[id] = static_cast<int>(task.predecessors.size());
-        task.ES = 0.0;
-        task.EF = 0.0;
-        task.LS = 0.0;
-        task.LF = 0.0;
-        task.slack = 0.0;
+        const double p = simulation.getProbabilityWithin(rule.time);
+        estimate = p;
+        // p(1 - p) is floored at 1/n so that p = 0 or 1 after a few samples does not stop the run.
+        const double spread = std::max(p * (1.0 - p), 1.0 / n);
+        return z * std::sqrt(spread / n);
+    }
 
-        if (inDegree[id] == 0)
+    case StoppingTarget::Percentile:
+    {
+        const double q = std::min(1.0, std::max(0.0, rule.percentile / 100.0));
+        const double spread = z * std::sqrt(q * (1.0 - q) / n);
+        const std::vector<double> bounds = simulation.getPercentiles(
+            {std::max(0.0, q - spread) * 100.0, q * 100.0, std::min(1.0, q + spread) * 100.0});
+        estimate = bounds[1];
+        return 0.5 * (bounds[2] - bounds[0]);
+    }
+
+    case StoppingTarget::None:
+        break;
+    }
+
+    estimate = 0.0;
+    return 0.0;
+}
+
+// Runs body(workspace, block, first, last) over the kSimulationBlockSize blocks
+// of [0, sampleCount); blocks are claimed dynamically by `threadCount` threads.
+template <typename Body>
+void forEachBlock(const MonteCarloEngine& engine, int sampleCount, int threadCount, const Body& body)
+{
+    const int blockCount = (sampleCount + kSimulationBlockSize - 1) / kSimulationBlockSize;
+    std::atomic<int> nextBlock{0};
+
+    auto worker = [&]()
+    {
+        MonteCarloEngine::Workspace workspace = engine.makeWorkspace();
+        for (int block = nextBlock++; block < blockCount; block = nextBlock++)
         {
-            task.ES = 0.0;
-            task.EF = task.expected_duration;
-            topoOrder.push_back(id);
+            const int first = block * kSimulationBlockSize;
+            body(workspace, block, first, std::min(first + kSimulationBlockSize, sampleCount));
         }
+    };
+
+    std::vector<std::thread> helpers;
+    const int threads = std::min(threadCount, blockCount);
+    helpers.reserve(std::max(0, threads - 1));
+    for (int t = 1; t < threads; ++t)
+    {
+        helpers.emplace_back(worker);
     }
+    worker();
+    for (std::thread& helper : helpers)
+    {
+        helper.join();
+    }
+}
+
+void storeSchedule(const ProjectSchedule<double>& schedule, std::map<int, Task_pert>& tasks)
+{
+    std::size_t index = 0;
+    for (auto& [id, task] : tasks)
+    {
+        task.ES = schedule.ES[index];
+        task.EF = schedule.EF[index];
+        task.LS = schedule.LS[index];
+        task.LF = schedule.LF[index];
+        task.slack = schedule.slack[index];
+        ++index;
+    }
+}
+
+// Critical path; also sums its variances.
+void extractCriticalPath(const ProjectGraph& graph,
+                         const ProjectSchedule<double>& schedule,
+                         PERTResult& result)
+{
+    const ArrayView<double> variances = graph.variances();
+    for (int index : LongestPath::criticalChain(graph, schedule))
+    {
+        result.criticalPath.push_back(graph.taskId(index));
+        result.variance += variances[index];
+    }
+
+    result.standardDeviation = std::sqrt(result.variance);
 }
 }
 
 PERTResult PERTCalculator::analyze(std::map<int, Task_pert>& tasks)
 {
-    PERTResult result;
     if (tasks.empty())
+    {
+        return {};
+    }
+
+    const ProjectGraph graph = ProjectGraph::compile(tasks);
+    ProjectSchedule<double> schedule;
+    PERTResult result = analyze(graph, schedule);
+    storeSchedule(schedule, tasks);
+    return result;
+}
+
+PERTResult PERTCalculator::analyze(const ProjectGraph& graph, ProjectSchedule<double>& schedule)
+{
+    PERTResult result;
+    const int taskCount = graph.size();
+    schedule.reset(taskCount);
+    if (taskCount == 0)
     {
         return result;
     }
 
-    std::map<int, int> inDegree;
-    std::vector<int> topoOrder;
-    initializeStartTimes(tasks, inDegree, topoOrder);
+    result.expectedDuration =
+        LongestPath::computeSchedule<LongestPath::Output::FullSchedule>(graph, graph.expectedDurations(), schedule);
+    extractCriticalPath(graph, schedule, result);
+    return result;
+}
 
-    // Forward pass.
-    std::size_t head = 0;
-    while (head < topoOrder.size())
+PERTResult PERTCalculator::analyzeParallel(const ProjectGraph& graph, ProjectSchedule<double>& schedule, ThreadPool& pool)
+{
+    if (!LevelScheduler::worthParallel(graph, pool))
     {
-        const int currentId = topoOrder[head++];
-        Task_pert& currentTask = tasks.at(currentId);
-        currentTask.EF = currentTask.ES + currentTask.expected_duration;
+        return analyze(graph, schedule);
+    }
 
-        for (int successorId : currentTask.successors)
+    PERTResult result;
+    schedule.reset(graph.size());
+    result.expectedDuration = LevelScheduler::computeSchedule(graph, graph.expectedDurations(), schedule, pool);
+    extractCriticalPath(graph, schedule, result);
+    return result;
+}
+
+void PERTSimulation::finalize()
+{
+    if (!sorted)
+    {
+        std::sort(completionTimes.begin(), completionTimes.end());
+        sorted = true;
+    }
+}
+
+double PERTSimulation::getPercentile(double percentile) const
+{
+    return getPercentiles({percentile}).front();
+}
+
+std::vector<double> PERTSimulation::getPercentiles(const std::vector<double>& percentiles) const
+{
+    std::vector<double> values(percentiles.size(), 0.0);
+    if (streaming)
+    {
+        for (std::size_t i = 0; i < percentiles.size(); ++i)
         {
-            Task_pert& successor = tasks.at(successorId);
-            successor.ES = std::max(successor.ES, currentTask.EF);
+            if (percentiles[i] >= 0.0 && percentiles[i] <= 100.0)
+            {
+                values[i] = sketch.quantile(percentiles[i] / 100.0);
+            }
+        }
+        return values;
+    }
+    if (completionTimes.empty())
+    {
+        return values;
+    }
 
-            auto it = inDegree.find(successorId);
-            if (it != inDegree.end() && --(it->second) == 0)
+    // Unsorted samples: place just the needed order statistics with nth_element
+    // instead of sorting everything.
+    const std::vector<double>* orderedTimes = &completionTimes;
+    std::vector<double> selectedTimes;
+    if (!sorted)
+    {
+        std::vector<std::size_t> ranks;
+        ranks.reserve(2 * percentiles.size());
+        for (double percentile : percentiles)
+        {
+            if (percentile >= 0.0 && percentile <= 100.0)
             {
-                topoOrder.push_back(successorId);
+                const double index = percentileIndex(percentile, completionTimes.size());
+                ranks.push_back(static_cast<std::size_t>(std::floor(index)));
+                ranks.push_back(static_cast<std::size_t>(std::ceil(index)));
             }
         }
+        std::sort(ranks.begin(), ranks.end());
+        ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+        selectedTimes = completionTimes;
+        selectRanks(selectedTimes.begin(), selectedTimes.end(), 0, ranks.data(), ranks.data() + ranks.size());
+        orderedTimes = &selectedTimes;
     }
 
-    // Determine expected project duration (mu).
-    for (const auto& [id, task] : tasks)
+    for (std::size_t i = 0; i < percentiles.size(); ++i)
     {
-        if (task.successors.empty())
+        if (percentiles[i] >= 0.0 && percentiles[i] <= 100.0)
         {
-            result.expectedDuration = std::max(result.expectedDuration, task.EF);
+            values[i] = interpolatePercentile(*orderedTimes, percentiles[i]);
         }
     }
+    return values;
+}
 
-    // Backward pass.
-    for (auto& [id, task] : tasks)
+double PERTSimulation::getProbabilityWithin(double time) const
+{
+    if (streaming)
     {
-        if (task.successors.empty())
+        return sketch.cumulativeProbability(time);
+    }
+    if (completionTimes.empty())
+    {
+        return 0.0;
+    }
+    if (sorted)
+    {
+        return countWithin(completionTimes, time);
+    }
+
+    std::size_t onTime = 0;
+    for (double completionTime : completionTimes)
+    {
+        if (completionTime <= time)
+        {
+            ++onTime;
+        }
+    }
+    return static_cast<double>(onTime) / completionTimes.size();
+}
+
+std::vector<double> PERTSimulation::getProbabilitiesWithin(const std::vector<double>& times) const
+{
+    std::vector<double> probabilities(times.size(), 0.0);
+    if (streaming)
+    {
+        for (std::size_t i = 0; i < times.size(); ++i)
         {
-            task.LF = result.expectedDuration;
+            probabilities[i] = sketch.cumulativeProbability(times[i]);
         }
+        return probabilities;
+    }
+    if (completionTimes.empty())
+    {
+        return probabilities;
+    }
+
+    const std::vector<double>* orderedTimes = &completionTimes;
+    std::vector<double> sortedTimes;
+    if (!sorted)
+    {
+        sortedTimes = completionTimes;
+        std::sort(sortedTimes.begin(), sortedTimes.end());
+        orderedTimes = &sortedTimes;
     }
 
-    for (int i = static_cast<int>(topoOrder.size()) - 1; i >= 0; --i)
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+        probabilities[i] = countWithin(*orderedTimes, times[i]);
+    }
+    return probabilities;
+}
+
+double ClarkEstimate::getPercentile(double percentile) const
+{
+    return getPercentiles({percentile}).front();
+}
+
+std::vector<double> ClarkEstimate::getPercentiles(const std::vector<double>& percentiles) const
+{
+    std::vector<double> probabilities(percentiles.size(), 0.0);
+    for (std::size_t i = 0; i < percentiles.size(); ++i)
     {
-        const int currentId = topoOrder[i];
-        Task_pert& currentTask = tasks.at(currentId);
+        probabilities[i] = percentiles[i] / 100.0;
+    }
+    std::vector<double> values(percentiles.size(), 0.0);
+    standardNormalQuantiles(probabilities.data(), values.data(), static_cast<int>(values.size()));
+    for (double& value : values)
+    {
+        value = std::min(upperBound, std::max(lowerBound, meanDuration + standardDeviation * value));
+    }
+    return values;
+}
 
-        if (!currentTask.successors.empty())
+double ClarkEstimate::getProbabilityWithin(double time) const
+{
+    if (time >= upperBound)
+    {
+        return 1.0;
+    }
+    if (time < lowerBound)
+    {
+        return 0.0;
+    }
+    if (standardDeviation == 0.0)
+    {
+        return time >= meanDuration ? 1.0 : 0.0;
+    }
+    return standardNormalCDF((time - meanDuration) / standardDeviation);
+}
+
+ClarkEstimate PERTCalculator::analyzeClark(const ProjectGraph& graph, const ClarkOptions& options)
+{
+    const DurationMoments moments = durationMoments(graph, options.distributions);
+    const ClarkApproximation::Moments completion =
+        ClarkApproximation::completion(graph, moments.means, moments.variances, options.correlationTerms);
+
+    ClarkEstimate estimate;
+    estimate.lowerBound = completionWith(graph, moments.lower);
+    estimate.upperBound = completionWith(graph, moments.upper);
+    estimate.meanDuration = completion.mean;
+    estimate.variance = completion.variance;
+    estimate.standardDeviation = std::sqrt(completion.variance);
+    if (estimate.standardDeviation > 0.0)
+    {
+        estimate.clippedMass =
+            standardNormalCDF((estimate.lowerBound - estimate.meanDuration) / estimate.standardDeviation) +
+            standardNormalCDF((estimate.meanDuration - estimate.upperBound) / estimate.standardDeviation);
+    }
+    else
+    {
+        estimate.clippedMass =
+            estimate.meanDuration < estimate.lowerBound || estimate.meanDuration > estimate.upperBound ? 1.0 : 0.0;
+    }
+    estimate.clipped = estimate.clippedMass > kClarkClipTolerance;
+    return estimate;
+}
+
+PERTSimulation PERTCalculator::analyzeSimulation(std::map<int, Task_pert>& tasks, int numSimulations)
+{
+    if (tasks.empty())
+    {
+        return {};
+    }
+
+    return analyzeSimulation(ProjectGraph::compile(tasks), numSimulations);
+}
+
+PERTSimulation PERTCalculator::analyzeSimulation(const ProjectGraph& graph, int numSimulations)
+{
+    SimulationOptions options;
+    options.numSimulations = numSimulations;
+    return analyzeSimulation(graph, options);
+}
+
+PERTSimulation PERTCalculator::analyzeSimulation(const ProjectGraph& graph, const SimulationOptions& options)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point startTime = Clock::now();
+
+    PERTSimulation result;
+    const int maxSimulations = options.numSimulations;
+    if (graph.empty() || maxSimulations <= 0)
+    {
+        return result;
+    }
+
+    result.seed = options.hasSeed ? options.seed : drawSeed();
+    result.streaming = !options.keepSamples;
+
+    const StoppingRule& stopping = options.stopping;
+    const bool hasTarget = stopping.target != StoppingTarget::None;
+    const bool hasBudget = stopping.timeBudgetSeconds > 0.0;
+    const Clock::time_point deadline =
+        startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(stopping.timeBudgetSeconds));
+
+    // Topology is prepared once; each run is a forward pass only.
+    const MonteCarloEngine engine(graph, options.distributions, options.sampling);
+
+    // Samples are handed out in fixed-size blocks. Every sample has its own random
+    // stream and every block its own statistics slot, and the slots are merged in
+    // block order, so the output does not depend on the number of threads.
+    // Streaming summaries and histograms are per thread; they merge by adding
+    // integer counts.
+    const int maxBlocks = (maxSimulations + kSimulationBlockSize - 1) / kSimulationBlockSize;
+    const int threadCount = resolveThreadCount(options.threadCount, maxBlocks);
+    std::vector<RunningStatistics> blockStatistics;
+    std::vector<QuantileSketch> threadSketches;
+    if (result.streaming)
+    {
+        threadSketches.assign(threadCount, QuantileSketch(options.sketchAccuracy));
+    }
+    HistogramSettings histogramSettings = options.histogram;
+    if (histogramSettings.binning == HistogramBinning::Fixed && histogramSettings.lower >= histogramSettings.upper)
+    {
+        histogramSettings.lower = engine.minCompletionTime();
+        histogramSettings.upper = engine.maxCompletionTime();
+    }
+    std::vector<Histogram> threadHistograms(threadCount, Histogram(histogramSettings));
+    std::vector<CriticalityStatistics> threadCriticality;
+    if (options.trackCriticality)
+    {
+        threadCriticality.assign(threadCount, engine.makeCriticalityStatistics());
+    }
+
+    // A run is a sequence of rounds over consecutive blocks; the stopping rule
+    // is checked between rounds. Blocks are claimed in order and every claimed
+    // block is finished, so a run cut short by the time budget still covers a
+    // prefix of the sample sequence.
+    std::atomic<int> nextBlock{0};
+    std::atomic<bool> outOfTime{false};
+    int roundEnd = 0;
+
+    auto worker = [&](int threadIndex)
+    {
+        MonteCarloEngine::Workspace workspace = engine.makeWorkspace();
+        QuantileSketch* sketch = result.streaming ? &threadSketches[threadIndex] : nullptr;
+        Histogram& histogram = threadHistograms[threadIndex];
+        CriticalityStatistics* criticality = options.trackCriticality ? &threadCriticality[threadIndex] : nullptr;
+
+        while (!outOfTime)
         {
-            double minLateStart = result.expectedDuration;
-            bool first = true;
-            for (int successorId : currentTask.successors)
+            const int block = nextBlock++;
+            if (block >= roundEnd)
+            {
+                break;
+            }
+
+            const int first = block * kSimulationBlockSize;
+            const int last = std::min(first + kSimulationBlockSize, maxSimulations);
+
+            RunningStatistics statistics;
+            auto record = [&](int sim, int completion)
+            {
+                const double completionTime = static_cast<double>(completion);
+                statistics.add(completionTime);
+                histogram.add(completionTime);
+                if (sketch != nullptr)
+                {
+                    sketch->add(completionTime);
+                }
+                else
+                {
+                    result.completionTimes[sim] = completionTime;
+                }
+            };
+
+            if (options.kernel == SimulationKernel::LaneBatched)
             {
-                const Task_pert& successor = tasks.at(successorId);
-                if (first || successor.LS < minLateStart)
+                int batch[MonteCarloEngine::kLaneCount];
+                for (int sim = first; sim < last; sim += MonteCarloEngine::kLaneCount)
                 {
-                    minLateStart = successor.LS;
-                    first = false;
+                    const int lanes = std::min(MonteCarloEngine::kLaneCount, last - sim);
+                    engine.sampleBatch(workspace, result.seed, sim, batch, criticality, lanes);
+                    for (int lane = 0; lane < lanes; ++lane)
+                    {
+                        record(sim + lane, batch[lane]);
+                    }
                 }
             }
-            currentTask.LF = minLateStart;
-        }
+            else
+            {
+                for (int sim = first; sim < last; ++sim)
+                {
+                    record(sim, engine.sample(workspace, result.seed, sim, criticality));
+                }
+            }
+            blockStatistics[block] = statistics;
 
-        currentTask.LS = currentTask.LF - currentTask.expected_duration;
-        currentTask.slack = currentTask.LF - currentTask.EF;
-    }
+            if (hasBudget && Clock::now() >= deadline)
+            {
+                outOfTime = true;
+            }
+        }
+    };
 
-    std::vector<int> criticalCandidates;
-    criticalCandidates.reserve(tasks.size());
-    for (const auto& [id, task] : tasks)
+    int blocksDone = 0;
+    int roundSimulations = hasTarget || hasBudget ? std::max(1, stopping.initialSimulations) : maxSimulations;
+    while (true)
     {
-        if (std::abs(task.slack) < kSlackTolerance)
+        roundEnd = std::min(maxBlocks, blocksDone + (roundSimulations + kSimulationBlockSize - 1) / kSimulationBlockSize);
+        blockStatistics.resize(roundEnd);
+        if (options.keepSamples)
         {
-            criticalCandidates.push_back(id);
+            result.completionTimes.resize(std::min<std::int64_t>(maxSimulations,
+                                                                 static_cast<std::int64_t>(roundEnd) * kSimulationBlockSize));
         }
-    }
 
-    std::sort(criticalCandidates.begin(), criticalCandidates.end(),
-              [&tasks](int lhs, int rhs)
-              {
-                  return tasks.at(lhs).ES < tasks.at(rhs).ES;
-              });
+        nextBlock = blocksDone;
+        std::vector<std::thread> helpers;
+        const int roundThreads = std::min(threadCount, roundEnd - blocksDone);
+        helpers.reserve(roundThreads - 1);
+        for (int t = 1; t < roundThreads; ++t)
+        {
+            helpers.emplace_back(worker, t);
+        }
+        worker(0);
+        for (std::thread& helper : helpers)
+        {
+            helper.join();
+        }
+        blocksDone = std::min(nextBlock.load(), roundEnd);
 
-    if (!criticalCandidates.empty())
-    {
-        result.criticalPath.push_back(criticalCandidates.front());
-        result.variance += tasks.at(criticalCandidates.front()).variance;
+        // Summaries of every sample so far.
+        result.simulations = static_cast<int>(std::min<std::int64_t>(
+            maxSimulations, static_cast<std::int64_t>(blocksDone) * kSimulationBlockSize));
+        RunningStatistics total;
+        for (int block = 0; block < blocksDone; ++block)
+        {
+            total.merge(blockStatistics[block]);
+        }
+        result.meanDuration = total.mean;
+        result.minDuration = total.min;
+        result.maxDuration = total.max;
+        result.standardDeviation = total.standardDeviation();
 
-        for (std::size_t idx = 1; idx < criticalCandidates.size(); ++idx)
+        result.histogram = threadHistograms.front();
+        for (int t = 1; t < threadCount; ++t)
+        {
+            result.histogram.merge(threadHistograms[t]);
+        }
+        if (result.streaming)
         {
-            const int currentId = criticalCandidates[idx];
-            const int previousId = result.criticalPath.back();
-            const Task_pert& previousTask = tasks.at(previousId);
-            const auto successorIt = std::find(previousTask.successors.begin(), previousTask.successors.end(), currentId);
-            if (successorIt != previousTask.successors.end())
+            result.sketch = threadSketches.front();
+            for (int t = 1; t < threadCount; ++t)
             {
-                result.criticalPath.push_back(currentId);
-                result.variance += tasks.at(currentId).variance;
+                result.sketch.merge(threadSketches[t]);
             }
         }
-    }
+        else
+        {
+            result.completionTimes.resize(result.simulations);
+        }
 
-    result.standardDeviation = std::sqrt(result.variance);
-    return result;
-}
+        if (hasTarget)
+        {
+            double estimate = 0.0;
+            result.achievedHalfWidth = confidenceHalfWidth(result, stopping, estimate);
+            result.targetHalfWidth = stopping.relative ? stopping.halfWidth * std::abs(estimate) : stopping.halfWidth;
+            if (result.achievedHalfWidth <= result.targetHalfWidth)
+            {
+                result.stopReason = StopReason::PrecisionReached;
+                break;
+            }
+        }
+        if (outOfTime)
+        {
+            result.stopReason = StopReason::TimeBudget;
+            break;
+        }
+        if (blocksDone >= maxBlocks)
+        {
+            result.stopReason = StopReason::SampleLimit;
+            break;
+        }
 
-double PERTSimulation::getPercentile(double percentile) const
-{
-    if (completionTimes.empty() || percentile < 0.0 || percentile > 100.0)
-    {
-        return 0.0;
+        // Half-width shrinks like 1/sqrt(n): aim just past the projected sample
+        // count, but never more than double the run in one round.
+        double projected = 2.0 * result.simulations;
+        if (hasTarget && result.targetHalfWidth > 0.0)
+        {
+            const double ratio = result.achievedHalfWidth / result.targetHalfWidth;
+            projected = std::min(projected, 1.1 * result.simulations * ratio * ratio);
+        }
+        roundSimulations = std::max(kSimulationBlockSize, static_cast<int>(std::min(projected - result.simulations,
+                                                                                   static_cast<double>(maxSimulations))));
     }
 
-    std::vector<double> sortedTimes = completionTimes;
-    std::sort(sortedTimes.begin(), sortedTimes.end());
-
-    const double index = (percentile / 100.0) * (sortedTimes.size() - 1);
-    const std::size_t lowerIndex = static_cast<std::size_t>(std::floor(index));
-    const std::size_t upperIndex = static_cast<std::size_t>(std::ceil(index));
+    if (!result.streaming)
+    {
+        result.finalize();
+    }
 
-    if (lowerIndex == upperIndex)
+    if (options.trackCriticality)
     {
-        return sortedTimes[lowerIndex];
+        CriticalityStatistics& criticality = threadCriticality.front();
+        for (int t = 1; t < threadCount; ++t)
+        {
+            criticality.merge(threadCriticality[t]);
+        }
+
+        // Tasks on a cycle are never simulated and keep index 0.
+        result.criticalityIndex.assign(graph.size(), 0.0);
+        result.cruciality.assign(graph.size(), 0.0);
+        for (int position = 0; position < engine.taskCount(); ++position)
+        {
+            const int index = engine.graphIndex(position);
+            result.criticalityIndex[index] = criticality.criticality(position);
+            result.cruciality[index] = criticality.cruciality(position);
+        }
     }
 
-    const double weight = index - lowerIndex;
-    return sortedTimes[lowerIndex] * (1.0 - weight) + sortedTimes[upperIndex] * weight;
+    return result;
 }
 
-PERTSimulation PERTCalculator::analyzeSimulation(std::map<int, Task_pert>& tasks, int numSimulations)
+OverrunEstimate PERTCalculator::analyzeOverrun(const ProjectGraph& graph,
+                                               double deadline,
+                                               const ImportanceSamplingOptions& options)
 {
-    PERTSimulation result;
-    if (tasks.empty() || numSimulations <= 0)
+    OverrunEstimate result;
+    result.deadline = deadline;
+    if (graph.empty() || options.numSimulations <= 0)
     {
         return result;
     }
 
-    result.simulations = numSimulations;
-    result.completionTimes.reserve(numSimulations);
+    // A deadline outside the support needs no sampling: P is exactly 0 or 1.
+    const DurationMoments moments = durationMoments(graph, options.distributions);
+    result.earliestCompletion = completionWith(graph, roundedDurations(moments.lower));
+    result.latestCompletion = completionWith(graph, roundedDurations(moments.upper));
+    if (deadline >= result.latestCompletion || deadline < result.earliestCompletion)
+    {
+        result.exact = true;
+        result.probability = deadline < result.earliestCompletion ? 1.0 : 0.0;
+        return result;
+    }
 
-    // Setup random number generation
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
-    // Run simulations
-    for (int sim = 0; sim < numSimulations; ++sim)
-    {
-        // Create a CPM task map with randomized durations
-        std::map<int, Task> cpmTasks;
-        
-        for (const auto& [id, pertTask] : tasks)
-        {
-            // Generate random duration using Beta distribution (PERT-style)
-            // Beta distribution parameters for PERT: alpha=4, beta=4
-            // This gives a bell-shaped distribution centered around most_likely_time
-            
-            const double a = static_cast<double>(pertTask.optimistic_time);
-            const double b = static_cast<double>(pertTask.pessimistic_time);
-                        
-            // Use uniform distribution between optimistic and pessimistic times
-            std::uniform_real_distribution<double> uniformDist(a, b);
-            double randomDuration = uniformDist(gen);
-            
-            // Create CPM task with random duration (rounded to integer)
-            Task cpmTask(id, static_cast<int>(std::round(randomDuration)));
-            cpmTask.predecessors = pertTask.predecessors;
-            cpmTask.successors = pertTask.successors;
-            
-            cpmTasks[id] = cpmTask;
-        }
-        
-        // Run CPM analysis on the randomized tasks
-        CPMResult cpmResult = CPMCalculator::analyze(cpmTasks);
-        
-        // Store the completion time
-        const double completionTime = static_cast<double>(cpmResult.totalDuration);
-        result.completionTimes.push_back(completionTime);
-        
-    }
-
-    // Calculate statistics
-    result.minDuration = *std::min_element(result.completionTimes.begin(), result.completionTimes.end());
-    result.maxDuration = *std::max_element(result.completionTimes.begin(), result.completionTimes.end());
-    
-    const double sum = std::accumulate(result.completionTimes.begin(), result.completionTimes.end(), 0.0);
-    result.meanDuration = sum / numSimulations;
-
-    // Calculate standard deviation
-    double sumSquaredDiff = 0.0;
-    for (double time : result.completionTimes)
-    {
-        const double diff = time - result.meanDuration;
-        sumSquaredDiff += diff * diff;
-    }
-    result.standardDeviation = std::sqrt(sumSquaredDiff / numSimulations);
+    result.seed = options.hasSeed ? options.seed : drawSeed();
+    result.tilts.assign(graph.size(), 1.0);
+    std::vector<double>& tilts = result.tilts;
+
+    const MonteCarloEngine engine(graph, options.distributions);
+    const int tuningSize = std::max(1, options.tuningSimulations);
+    const int maxSamples = std::max(tuningSize, options.numSimulations);
+    const int threadCount = resolveThreadCount(options.threadCount,
+                                               (maxSamples + kSimulationBlockSize - 1) / kSimulationBlockSize);
+
+    // Cross-entropy tuning; every iteration draws from its own seed.
+    std::vector<int> completions(tuningSize);
+    std::vector<double> logRatios(tuningSize);
+    std::vector<double> logUnitSums(graph.size());
+    MonteCarloEngine::Workspace eliteWorkspace = engine.makeWorkspace();
+    int previousLevel = 0;
+    for (int iteration = 0; iteration < options.maxIterations; ++iteration)
+    {
+        const std::uint64_t iterationSeed = RandomStream(result.seed, kTuningStream).at(iteration);
+        forEachBlock(engine, tuningSize, threadCount,
+                     [&](MonteCarloEngine::Workspace& workspace, int, int first, int last)
+                     {
+                         for (int sim = first; sim < last; ++sim)
+                         {
+                             completions[sim] = engine.sampleTilted(workspace, iterationSeed, sim, tilts, logRatios[sim]);
+                         }
+                     });
+        result.tuningSimulations += tuningSize;
+        ++result.iterations;
+
+        std::vector<int> ordered = completions;
+        const std::size_t levelRank = std::min(ordered.size() - 1, static_cast<std::size_t>(
+            std::floor((1.0 - options.rarity) * static_cast<double>(ordered.size()))));
+        std::nth_element(ordered.begin(), ordered.begin() + levelRank, ordered.end());
+        int level = ordered[levelRank];
+        if (iteration > 0 && level <= previousLevel)
+        {
+            // Ties at the quantile (completion times are whole units) would stall
+            // the level; move to the next completion time above the previous one.
+            for (int completion : completions)
+            {
+                if (completion > previousLevel && (level <= previousLevel || completion < level))
+                {
+                    level = completion;
+                }
+            }
+        }
+        previousLevel = level;
+
+        const bool finalLevel = level >= deadline;
+        auto isElite = [&](int completion)
+        {
+            return finalLevel ? completion > deadline : completion >= level;
+        };
+
+        // Likelihood ratios relative to the largest elite one; the fit only needs ratios.
+        double maxLogRatio = -std::numeric_limits<double>::infinity();
+        for (int sim = 0; sim < tuningSize; ++sim)
+        {
+            if (isElite(completions[sim]))
+            {
+                maxLogRatio = std::max(maxLogRatio, logRatios[sim]);
+            }
+        }
+        if (maxLogRatio == -std::numeric_limits<double>::infinity())
+        {
+            break;
+        }
+
+        // Weighted maximum likelihood of Beta(theta, 1): theta = -sum(w) / sum(w log u).
+        // The elite samples are regenerated from their streams to recover log u.
+        double weightSum = 0.0;
+        std::fill(logUnitSums.begin(), logUnitSums.end(), 0.0);
+        for (int sim = 0; sim < tuningSize; ++sim)
+        {
+            if (!isElite(completions[sim]))
+            {
+                continue;
+            }
+            double logRatio = 0.0;
+            engine.sampleTilted(eliteWorkspace, iterationSeed, sim, tilts, logRatio);
+            const double weight = std::exp(logRatio - maxLogRatio);
+            weightSum += weight;
+            for (int index = 0; index < graph.size(); ++index)
+            {
+                logUnitSums[index] += weight * eliteWorkspace.logUnits[index];
+            }
+        }
+
+        for (int index = 0; index < graph.size(); ++index)
+        {
+            const double fitted = logUnitSums[index] < 0.0 ? -weightSum / logUnitSums[index] : kMaxTilt;
+            const double smoothed = options.smoothing * fitted + (1.0 - options.smoothing) * tilts[index];
+            tilts[index] = std::min(kMaxTilt, std::max(1.0, smoothed));
+        }
+
+        if (finalLevel)
+        {
+            break;
+        }
+    }
+
+    // Final run: per-block partial sums merged in block order.
+    const int numSimulations = options.numSimulations;
+    const int blockCount = (numSimulations + kSimulationBlockSize - 1) / kSimulationBlockSize;
+    std::vector<double> blockSums(blockCount, 0.0);
+    std::vector<double> blockSquares(blockCount, 0.0);
+    forEachBlock(engine, numSimulations, threadCount,
+                 [&](MonteCarloEngine::Workspace& workspace, int block, int first, int last)
+                 {
+                     double sum = 0.0;
+                     double squares = 0.0;
+                     for (int sim = first; sim < last; ++sim)
+                     {
+                         double logRatio = 0.0;
+                         if (engine.sampleTilted(workspace, result.seed, sim, tilts, logRatio) > deadline)
+                         {
+                             const double weight = std::exp(logRatio);
+                             sum += weight;
+                             squares += weight * weight;
+                         }
+                     }
+                     blockSums[block] = sum;
+                     blockSquares[block] = squares;
+                 });
+
+    double sum = 0.0;
+    double squares = 0.0;
+    for (int block = 0; block < blockCount; ++block)
+    {
+        sum += blockSums[block];
+        squares += blockSquares[block];
+    }
 
+    const double n = static_cast<double>(numSimulations);
+    result.simulations = numSimulations;
+    result.probability = sum / n;
+    if (numSimulations > 1)
+    {
+        const double variance = std::max(0.0, squares / n - result.probability * result.probability);
+        result.standardError = std::sqrt(variance / (n - 1.0));
+    }
+    result.effectiveSampleSize = squares > 0.0 ? sum * sum / squares : 0.0;
     return result;
-}
\ No newline at end of file
+}
@@ -1,11 +1,18 @@
 #ifndef PERT_CALCULATOR_H
 #define PERT_CALCULATOR_H
 
+#include <cstdint>
 #include <map>
 #include <vector>
 
+#include "DurationDistribution.h"
+#include "ProjectGraph.h"
+#include "SampleSequence.h"
+#include "SimulationStatistics.h"
 #include "Task_pert.h"
 
+class ThreadPool;
+
 struct PERTResult
 {
     double expectedDuration = 0.0;
@@ -14,24 +21,201 @@ struct PERTResult
     std::vector<int> criticalPath;
 };
 
+enum class SimulationKernel
+{
+    Scalar,      // one sample per forward pass
+    LaneBatched  // MonteCarloEngine::kLaneCount samples per forward pass (SIMD)
+};
+
+enum class StoppingTarget
+{
+    None,        // run numSimulations samples (or until the time budget)
+    Mean,        // mean completion time
+    Probability, // P(T <= time)
+    Percentile   // completion time at `percentile`
+};
+
+// Adaptive stopping: the simulation runs in rounds of sample blocks and stops
+// once the confidence interval of the target statistic is narrow enough, the
+// time budget is spent or numSimulations (then an upper bound) is reached.
+// Without a time budget the stopping point depends only on the seed.
+struct StoppingRule
+{
+    StoppingTarget target = StoppingTarget::None;
+    double halfWidth = 0.0;          // target half-width (probability units for Probability)
+    bool relative = false;           // halfWidth as a fraction of the estimate
+    double confidence = 0.95;
+    double time = 0.0;               // Probability: deadline
+    double percentile = 50.0;        // Percentile: 0..100
+    double timeBudgetSeconds = 0.0;  // wall-clock limit, 0 = none
+    int initialSimulations = 16384;  // size of the first round
+};
+
+enum class StopReason
+{
+    SampleLimit,      // numSimulations reached
+    PrecisionReached, // StoppingRule half-width met
+    TimeBudget        // StoppingRule::timeBudgetSeconds spent
+};
+
+struct SimulationOptions
+{
+    int numSimulations = 0;   // exact count, or the upper bound with a stopping rule
+    SimulationKernel kernel = SimulationKernel::LaneBatched;
+    int threadCount = 0;      // 0 = one thread per hardware core
+    std::uint64_t seed = 0;
+    bool hasSeed = false;     // draw a fresh seed from std::random_device when false
+
+    // Streaming mode (keepSamples = false): completion times are folded into a
+    // quantile sketch instead of being stored, so memory stays constant for any
+    // numSimulations.
+    bool keepSamples = true;
+    double sketchAccuracy = 0.001;  // relative error bound of the quantile sketch
+
+    // Binning of the completion-time histogram, which is filled during the run in both modes.
+    HistogramSettings histogram;
+
+    // Record which predecessor decided each task's start and derive per-task
+    // criticality and cruciality indices (see PERTSimulation).
+    bool trackCriticality = false;
+
+    DistributionSettings distributions;
+    SamplingScheme sampling = SamplingScheme::Random;
+    StoppingRule stopping;
+};
+
 struct PERTSimulation
 {
-    int simulations = 0;
+    int simulations = 0;      // samples actually used
+    std::uint64_t seed = 0;   // seed that reproduces this run
+    StopReason stopReason = StopReason::SampleLimit;
+    double achievedHalfWidth = 0.0; // confidence-interval half-width of the stopping target
+    double targetHalfWidth = 0.0;   // requested half-width (absolute)
     double meanDuration = 0.0;
     double minDuration = 0.0;
     double maxDuration = 0.0;
     double standardDeviation = 0.0;
-    std::vector<double> completionTimes; // All simulation results
-    
-    // Percentile calculations
+    std::vector<double> completionTimes; // All simulation results (empty in streaming mode)
+    bool sorted = false;                  // completionTimes in ascending order (see finalize())
+
+    // Streaming mode summary.
+    bool streaming = false;
+    QuantileSketch sketch;
+
+    // Completion-time histogram with the bins of SimulationOptions::histogram.
+    Histogram histogram;
+
+    // Per-task indices, indexed like ProjectGraph (ascending task id); empty
+    // unless SimulationOptions::trackCriticality was set.
+    std::vector<double> criticalityIndex; // fraction of runs in which the task was on the critical path
+    std::vector<double> cruciality;       // correlation between task duration and completion time
+
+    // Sorts completionTimes once so every later query is a lookup or binary search.
+    // analyzeSimulation returns finalized results.
+    void finalize();
+
+    // Percentile calculations (within sketch.relativeAccuracy() in streaming mode)
+    double getPercentile(double percentile) const;
+    std::vector<double> getPercentiles(const std::vector<double>& percentiles) const;
+
+    // Fraction of runs finished by `time` (P(T <= time)); in streaming mode exact
+    // for some time within sketch.relativeAccuracy().
+    double getProbabilityWithin(double time) const;
+    std::vector<double> getProbabilitiesWithin(const std::vector<double>& times) const;
+};
+
+// Importance sampling of the overrun probability P(T > deadline). Every task
+// draw u is tilted to Beta(theta, 1) (u = v^(1/theta)), which pushes durations
+// towards their pessimistic end for theta > 1; samples are weighted by the
+// likelihood ratio. The per-task tilts are tuned by multilevel cross-entropy:
+// each iteration raises the level to the (1 - rarity) quantile of the
+// completion times (capped at the deadline) and refits the tilts to the
+// weighted elite samples, until the deadline itself is the level. A deadline
+// at or past the latest possible completion (or before the earliest) has an
+// exact answer and is not sampled.
+struct ImportanceSamplingOptions
+{
+    int numSimulations = 100000;     // final estimation run
+    int tuningSimulations = 10000;   // per cross-entropy iteration
+    int maxIterations = 20;
+    double rarity = 0.1;             // elite fraction per iteration
+    double smoothing = 0.7;          // weight of the new tilts in each update
+    int threadCount = 0;             // 0 = one thread per hardware core
+    std::uint64_t seed = 0;
+    bool hasSeed = false;
+    DistributionSettings distributions;
+};
+
+struct OverrunEstimate
+{
+    double deadline = 0.0;
+    std::uint64_t seed = 0;
+    double probability = 0.0;         // P(T > deadline)
+    double standardError = 0.0;
+    double effectiveSampleSize = 0.0; // (sum w)^2 / sum w^2 over the overrun samples
+    int simulations = 0;              // final run
+    int tuningSimulations = 0;        // spent by the cross-entropy iterations
+    int iterations = 0;
+    std::vector<double> tilts;        // per task, indexed like ProjectGraph; 1 = untilted
+    double earliestCompletion = 0.0;  // every task at the bottom of its distribution
+    double latestCompletion = 0.0;    // ... and at the top (+inf with LogNormal tasks)
+    bool exact = false;               // deadline outside [earliest, latest): probability is 0 or 1, nothing sampled
+};
+
+// Analytic completion-time distribution (ClarkApproximation): one pass over
+// the graph instead of a simulation. Unlike PERTResult, which takes the
+// variance of a single critical path, it accounts for the merge bias of
+// parallel near-critical branches. correlationTerms bounds the shared upstream
+// tasks tracked per finish time; 0 treats all predecessors as independent.
+//
+// The normal tails ignore that durations are bounded, which overshoots on wide
+// merges of many short tasks (pert_data_3.txt). The mean and variance are
+// Clark's own; the percentiles and probabilities are clipped to the project's
+// support, and `clipped` marks an estimate whose normal puts a noticeable part
+// of its mass outside it, so the clipped percentiles are bounds, not estimates.
+struct ClarkOptions
+{
+    int correlationTerms = 32;
+    DistributionSettings distributions;
+};
+
+struct ClarkEstimate
+{
+    double meanDuration = 0.0;
+    double variance = 0.0;
+    double standardDeviation = 0.0;
+    double lowerBound = 0.0; // completion with every task at the bottom of its distribution
+    double upperBound = 0.0; // ... and at the top (+inf with LogNormal tasks)
+    double clippedMass = 0.0; // probability the normal gives to times outside the bounds
+    bool clipped = false;     // clippedMass above 0.1%
+
+    // Normal approximation of the completion time, clipped to the bounds.
     double getPercentile(double percentile) const;
+    std::vector<double> getPercentiles(const std::vector<double>& percentiles) const;
+    double getProbabilityWithin(double time) const;
 };
 
 class PERTCalculator
 {
 public:
     static PERTResult analyze(std::map<int, Task_pert>& tasks);
+    static PERTResult analyze(const ProjectGraph& graph, ProjectSchedule<double>& schedule);
+
+    // Same result as analyze; wide graphs run the passes level by level on `pool`.
+    static PERTResult analyzeParallel(const ProjectGraph& graph, ProjectSchedule<double>& schedule, ThreadPool& pool);
+
     static PERTSimulation analyzeSimulation(std::map<int, Task_pert>& tasks, int numSimulations);
+    static PERTSimulation analyzeSimulation(const ProjectGraph& graph, int numSimulations);
+
+    // Same seed gives bit-identical results for any thread count.
+    static PERTSimulation analyzeSimulation(const ProjectGraph& graph, const SimulationOptions& options);
+
+    static ClarkEstimate analyzeClark(const ProjectGraph& graph, const ClarkOptions& options = ClarkOptions());
+
+    // Same seed gives bit-identical results for any thread count.
+    static OverrunEstimate analyzeOverrun(const ProjectGraph& graph,
+                                          double deadline,
+                                          const ImportanceSamplingOptions& options);
 };
 
 #endif // PERT_CALCULATOR_H
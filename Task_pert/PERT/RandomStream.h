@@ -0,0 +1,44 @@
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+#include <cstdint>
+
+// Counter-based random stream (SplitMix64 finalizer over a Weyl sequence).
+// Draw i of stream s is a pure function of (seed, s, i), so every Monte Carlo
+// sample owns its own stream and can be generated on any thread in any order.
+class RandomStream
+{
+public:
+    RandomStream() = default;
+
+    RandomStream(std::uint64_t seed, std::uint64_t streamId)
+        : key_(mix(seed + mix(streamId + kIncrement)))
+    {
+    }
+
+    // Raw 64-bit value at position `counter` of this stream.
+    std::uint64_t at(std::uint64_t counter) const
+    {
+        return mix(key_ + (counter + 1) * kIncrement);
+    }
+
+    // Uniform double in [0, 1) at position `counter` of this stream.
+    double unitAt(std::uint64_t counter) const
+    {
+        return static_cast<double>(at(counter) >> 11) * 0x1.0p-53;
+    }
+
+private:
+    static constexpr std::uint64_t kIncrement = 0x9E3779B97F4A7C15ULL;
+
+    static std::uint64_t mix(std::uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    std::uint64_t key_ = 0;
+};
+
+#endif // RANDOM_STREAM_H
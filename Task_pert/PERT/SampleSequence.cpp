@@ -0,0 +1,272 @@
+#include "SampleSequence.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+constexpr int kLatinStratumBits = 12;
+constexpr int kUnitBits = 53;
+constexpr std::uint64_t kLatinStream = 0x4C48530000000001ULL;
+constexpr std::uint64_t kSobolStream = 0x534F424F4C000001ULL;
+constexpr std::uint64_t kSobolInitialSeed = 0x2545F4914F6CDD1DULL;
+
+static_assert((1 << kLatinStratumBits) == SampleSequence::kLatinStratumSize,
+              "Latin strata are indexed by a Feistel network over whole bits");
+
+// Four-round Feistel network on kLatinStratumBits bits: a bijection of
+// [0, kLatinStratumSize) selected by `key`.
+std::uint32_t permuteStratum(std::uint32_t value, std::uint64_t key)
+{
+    constexpr int halfBits = kLatinStratumBits / 2;
+    constexpr std::uint32_t halfMask = (1u << halfBits) - 1;
+
+    std::uint32_t left = value >> halfBits;
+    std::uint32_t right = value & halfMask;
+    for (int round = 0; round < 4; ++round)
+    {
+        std::uint32_t mixed = (right ^ static_cast<std::uint32_t>(key >> (16 * round))) * 0x2C1B3C6Du;
+        mixed ^= mixed >> 15;
+        mixed *= 0x297A2D39u;
+        mixed ^= mixed >> 12;
+        const std::uint32_t next = left ^ (mixed & halfMask);
+        left = right;
+        right = next;
+    }
+    return (left << halfBits) | right;
+}
+
+std::uint32_t reverseBits(std::uint32_t value)
+{
+    value = ((value >> 1) & 0x55555555u) | ((value & 0x55555555u) << 1);
+    value = ((value >> 2) & 0x33333333u) | ((value & 0x33333333u) << 2);
+    value = ((value >> 4) & 0x0F0F0F0Fu) | ((value & 0x0F0F0F0Fu) << 4);
+    value = ((value >> 8) & 0x00FF00FFu) | ((value & 0x00FF00FFu) << 8);
+    return (value >> 16) | (value << 16);
+}
+
+// Hash-based nested uniform scramble (Burley 2020): a Laine-Karras style
+// permutation on the bit-reversed value scrambles every digit depending only
+// on the digits above it.
+std::uint32_t nestedUniformScramble(std::uint32_t value, std::uint32_t seed)
+{
+    value = reverseBits(value);
+    value ^= value * 0x3D20ADEAu;
+    value += seed;
+    value *= (seed >> 16) | 1u;
+    value ^= value * 0x05526C56u;
+    value ^= value * 0x53A22864u;
+    return reverseBits(value);
+}
+
+// Product of two polynomials over GF(2) (bit i = coefficient of x^i) modulo
+// `modulus` of the given degree.
+std::uint32_t multiplyModulo(std::uint32_t lhs, std::uint32_t rhs, std::uint32_t modulus, int degree)
+{
+    std::uint32_t product = 0;
+    while (rhs != 0)
+    {
+        if ((rhs & 1u) != 0)
+        {
+            product ^= lhs;
+        }
+        rhs >>= 1;
+        lhs <<= 1;
+        if ((lhs >> degree) & 1u)
+        {
+            lhs ^= modulus;
+        }
+    }
+    return product;
+}
+
+std::uint32_t powerOfX(std::uint32_t exponent, std::uint32_t modulus, int degree)
+{
+    std::uint32_t result = 1;
+    std::uint32_t base = degree > 1 ? 2u : (2u ^ modulus); // x mod p
+    while (exponent != 0)
+    {
+        if ((exponent & 1u) != 0)
+        {
+            result = multiplyModulo(result, base, modulus, degree);
+        }
+        base = multiplyModulo(base, base, modulus, degree);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+// p is primitive when x has multiplicative order exactly 2^degree - 1 modulo p.
+bool isPrimitive(std::uint32_t polynomial, int degree, const std::vector<std::uint32_t>& primeFactors)
+{
+    const std::uint32_t order = (1u << degree) - 1;
+    if (powerOfX(order, polynomial, degree) != 1)
+    {
+        return false;
+    }
+    for (std::uint32_t factor : primeFactors)
+    {
+        if (factor != order && powerOfX(order / factor, polynomial, degree) == 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::uint32_t> primeFactors(std::uint32_t value)
+{
+    std::vector<std::uint32_t> factors;
+    for (std::uint32_t divisor = 2; divisor * divisor <= value; ++divisor)
+    {
+        if (value % divisor == 0)
+        {
+            factors.push_back(divisor);
+            while (value % divisor == 0)
+            {
+                value /= divisor;
+            }
+        }
+    }
+    if (value > 1)
+    {
+        factors.push_back(value);
+    }
+    return factors;
+}
+}
+
+SampleSequence::SampleSequence(SamplingScheme scheme, const ProjectGraph& graph)
+    : scheme_(scheme)
+{
+    if (scheme_ == SamplingScheme::Sobol)
+    {
+        buildSobolDirections(graph);
+    }
+}
+
+void SampleSequence::buildSobolDirections(const ProjectGraph& graph)
+{
+    const int taskCount = graph.size();
+
+    // Primitive polynomials in increasing degree; bit s of a degree-s polynomial is set.
+    std::vector<std::uint32_t> polynomials;
+    std::vector<int> degrees;
+    for (int degree = 1; degree <= kMaxPolynomialDegree && static_cast<int>(polynomials.size()) + 1 < taskCount; ++degree)
+    {
+        const std::vector<std::uint32_t> factors = primeFactors((1u << degree) - 1);
+        for (std::uint32_t polynomial = (1u << degree) | 1u; polynomial < (2u << degree); polynomial += 2)
+        {
+            if (isPrimitive(polynomial, degree, factors))
+            {
+                polynomials.push_back(polynomial);
+                degrees.push_back(degree);
+            }
+        }
+    }
+
+    const int dimensions = std::min(taskCount, static_cast<int>(polynomials.size()) + 1);
+    directions_.assign(static_cast<std::size_t>(dimensions) * kSobolBits, 0);
+
+    // Dimension 0 is the van der Corput sequence.
+    for (int bit = 0; bit < kSobolBits && dimensions > 0; ++bit)
+    {
+        directions_[bit] = 1u << (kSobolBits - 1 - bit);
+    }
+
+    for (int dimension = 1; dimension < dimensions; ++dimension)
+    {
+        const std::uint32_t polynomial = polynomials[dimension - 1];
+        const int degree = degrees[dimension - 1];
+        const RandomStream initial(kSobolInitialSeed, static_cast<std::uint64_t>(dimension));
+
+        // m_k odd and below 2^k: free for k <= degree, then the Bratley-Fox recurrence.
+        std::uint32_t m[kSobolBits + 1] = {};
+        for (int k = 1; k <= kSobolBits; ++k)
+        {
+            if (k <= degree)
+            {
+                m[k] = (static_cast<std::uint32_t>(initial.at(k)) & ((1u << k) - 1)) | 1u;
+                continue;
+            }
+            std::uint32_t value = m[k - degree] ^ (m[k - degree] << degree);
+            for (int i = 1; i < degree; ++i)
+            {
+                if ((polynomial >> (degree - i)) & 1u)
+                {
+                    value ^= m[k - i] << i;
+                }
+            }
+            m[k] = value;
+        }
+
+        std::uint32_t* v = directions_.data() + static_cast<std::size_t>(dimension) * kSobolBits;
+        for (int k = 1; k <= kSobolBits; ++k)
+        {
+            v[k - 1] = m[k] << (kSobolBits - k);
+        }
+    }
+
+    // The low dimensions are the best distributed: give them to the tasks with
+    // the widest optimistic-pessimistic range.
+    const ArrayView<int> optimistic = graph.optimisticTimes();
+    const ArrayView<int> pessimistic = graph.pessimisticTimes();
+    std::vector<int> byRange(taskCount);
+    std::iota(byRange.begin(), byRange.end(), 0);
+    if (!optimistic.empty())
+    {
+        std::stable_sort(byRange.begin(), byRange.end(),
+                         [&](int lhs, int rhs)
+                         {
+                             return pessimistic[lhs] - optimistic[lhs] > pessimistic[rhs] - optimistic[rhs];
+                         });
+    }
+
+    sobolDimensions_.assign(taskCount, -1);
+    for (int dimension = 0; dimension < dimensions; ++dimension)
+    {
+        sobolDimensions_[byRange[dimension]] = dimension;
+    }
+}
+
+double SampleSequence::latinUnit(const RandomStream& stream,
+                                 std::uint64_t seed,
+                                 std::uint64_t sampleIndex,
+                                 int index) const
+{
+    const std::uint64_t block = sampleIndex >> kLatinStratumBits;
+    const std::uint32_t offset = static_cast<std::uint32_t>(sampleIndex & (kLatinStratumSize - 1));
+    const std::uint64_t key = RandomStream(seed ^ kLatinStream, block).at(static_cast<std::uint64_t>(index));
+
+    // Stratum in the top bits, jitter below: exact on the 2^-53 grid and below 1.
+    const std::uint64_t stratum = permuteStratum(offset, key);
+    const std::uint64_t bits = (stratum << (kUnitBits - kLatinStratumBits)) |
+                               (stream.at(index) >> (64 - kUnitBits + kLatinStratumBits));
+    return static_cast<double>(bits) * 0x1.0p-53;
+}
+
+double SampleSequence::sobolUnit(const RandomStream& stream,
+                                 std::uint64_t seed,
+                                 std::uint64_t sampleIndex,
+                                 int index) const
+{
+    const int dimension = sobolDimensions_[index];
+    const std::uint32_t* v = directions_.data() + static_cast<std::size_t>(dimension) * kSobolBits;
+
+    std::uint32_t point = 0;
+    int bit = 0;
+    for (std::uint64_t remaining = sampleIndex; remaining != 0 && bit < kSobolBits; remaining >>= 1, ++bit)
+    {
+        if ((remaining & 1u) != 0)
+        {
+            point ^= v[bit];
+        }
+    }
+
+    const std::uint32_t scrambleSeed = static_cast<std::uint32_t>(RandomStream(seed, kSobolStream).at(dimension));
+    point = nestedUniformScramble(point, scrambleSeed);
+
+    const std::uint64_t bits = (static_cast<std::uint64_t>(point) << (kUnitBits - kSobolBits)) |
+                               (stream.at(index) >> (64 - kUnitBits + kSobolBits));
+    return static_cast<double>(bits) * 0x1.0p-53;
+}
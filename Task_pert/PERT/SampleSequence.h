@@ -0,0 +1,86 @@
+#ifndef SAMPLE_SEQUENCE_H
+#define SAMPLE_SEQUENCE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ProjectGraph.h"
+#include "RandomStream.h"
+
+// How the uniform draws behind the task durations are generated.
+enum class SamplingScheme
+{
+    Random,         // independent pseudo-random draws
+    Antithetic,     // samples 2k and 2k+1 use u and 1 - u
+    LatinHypercube, // every block of kLatinStratumSize samples is a Latin hypercube over the tasks
+    Sobol           // Owen-scrambled Sobol points, one dimension per task
+};
+
+// Uniform draw u(sample, task) of a simulation run. Like RandomStream, every
+// draw is a pure function of (seed, sample index, graph task index), so the
+// schemes keep results independent of the thread count and of lane batching.
+//
+// Latin hypercube: within a block, task j of sample i falls in stratum
+// pi_j(i) of 1/kLatinStratumSize width, with pi_j a keyed permutation
+// (cycle-walking Feistel network) and a uniform jitter inside the stratum.
+//
+// Sobol: direction numbers come from primitive polynomials over GF(2) (all of
+// degree <= 13, generated at construction) with fixed pseudo-random initial
+// values. Dimensions go to the tasks with the widest duration range first;
+// tasks beyond the last dimension fall back to pseudo-random draws. Each
+// dimension gets a hash-based nested uniform (Owen) scramble keyed by the
+// seed, and the bits below the 32-bit Sobol resolution are filled randomly.
+class SampleSequence
+{
+public:
+    static constexpr int kLatinStratumSize = 4096;
+
+    SampleSequence() = default;
+    SampleSequence(SamplingScheme scheme, const ProjectGraph& graph);
+
+    SamplingScheme scheme() const { return scheme_; }
+
+    // Stream whose draws (or jitter) feed sample `sampleIndex`; antithetic
+    // pairs share the stream of their even member.
+    RandomStream stream(std::uint64_t seed, std::uint64_t sampleIndex) const
+    {
+        return RandomStream(seed, scheme_ == SamplingScheme::Antithetic ? sampleIndex & ~std::uint64_t{1} : sampleIndex);
+    }
+
+    // Draw in [0, 1) of graph task `index`; `stream` must be stream(seed, sampleIndex).
+    double unit(const RandomStream& stream, std::uint64_t seed, std::uint64_t sampleIndex, int index) const
+    {
+        switch (scheme_)
+        {
+        case SamplingScheme::Antithetic:
+            return (sampleIndex & 1) != 0 ? mirror(stream.unitAt(index)) : stream.unitAt(index);
+        case SamplingScheme::LatinHypercube:
+            return latinUnit(stream, seed, sampleIndex, index);
+        case SamplingScheme::Sobol:
+            return sobolDimensions_[index] >= 0 ? sobolUnit(stream, seed, sampleIndex, index) : stream.unitAt(index);
+        case SamplingScheme::Random:
+            break;
+        }
+        return stream.unitAt(index);
+    }
+
+    int sobolDimensionCount() const { return static_cast<int>(directions_.size() / kSobolBits); }
+
+private:
+    static constexpr int kSobolBits = 32;
+    static constexpr int kMaxPolynomialDegree = 13;
+
+    // 1 - u on the 2^-53 grid of RandomStream::unitAt, kept inside [0, 1).
+    static double mirror(double unit) { return (1.0 - 0x1.0p-53) - unit; }
+
+    double latinUnit(const RandomStream& stream, std::uint64_t seed, std::uint64_t sampleIndex, int index) const;
+    double sobolUnit(const RandomStream& stream, std::uint64_t seed, std::uint64_t sampleIndex, int index) const;
+
+    void buildSobolDirections(const ProjectGraph& graph);
+
+    SamplingScheme scheme_ = SamplingScheme::Random;
+    std::vector<int> sobolDimensions_;       // graph index -> dimension, -1 when pseudo-random
+    std::vector<std::uint32_t> directions_;  // kSobolBits direction numbers per dimension
+};
+
+#endif // SAMPLE_SEQUENCE_H
@@ -0,0 +1,483 @@
+#include "SimulationStatistics.h"
+
+#include <utility>
+
+namespace
+{
+constexpr double kMinIndexable = 1e-9;
+}
+
+Histogram::Histogram(const HistogramSettings& settings)
+    : settings_(settings)
+{
+    settings_.width = settings_.width > 0.0 ? settings_.width : 1.0;
+    settings_.subBuckets = std::max(1, settings_.subBuckets);
+    switch (settings_.binning)
+    {
+    case HistogramBinning::Fixed:
+    {
+        counts_.assign(std::max(1, settings_.bins), 0);
+        const double range = settings_.upper - settings_.lower;
+        binsPerUnit_ = range > 0.0 ? static_cast<double>(counts_.size()) / range : 0.0;
+        break;
+    }
+    case HistogramBinning::Adaptive:
+        // Two bins always suffice: halving maps any pair of indices to adjacent ones.
+        settings_.bins = std::max(2, settings_.bins);
+        width_ = settings_.width;
+        break;
+    case HistogramBinning::LogLinear:
+        break;
+    }
+}
+
+std::int64_t Histogram::gridIndex(double value) const
+{
+    if (settings_.binning == HistogramBinning::Adaptive)
+    {
+        return static_cast<std::int64_t>(std::floor(value / width_));
+    }
+
+    const int subBuckets = settings_.subBuckets;
+    const double scaled = std::max(0.0, value) / settings_.width;
+    if (scaled < subBuckets)
+    {
+        return static_cast<std::int64_t>(scaled);
+    }
+
+    // scaled = mantissa * 2^exponent with mantissa in [subBuckets, 2 * subBuckets).
+    int exponent = std::ilogb(scaled / subBuckets);
+    double mantissa = std::ldexp(scaled, -exponent);
+    if (mantissa < subBuckets)
+    {
+        --exponent;
+        mantissa *= 2.0;
+    }
+    else if (mantissa >= 2.0 * subBuckets)
+    {
+        ++exponent;
+        mantissa *= 0.5;
+    }
+    const int sub = std::min(subBuckets - 1, static_cast<int>(mantissa) - subBuckets);
+    return subBuckets + static_cast<std::int64_t>(exponent) * subBuckets + sub;
+}
+
+double Histogram::gridStart(std::int64_t index) const
+{
+    if (settings_.binning == HistogramBinning::Adaptive)
+    {
+        return static_cast<double>(index) * width_;
+    }
+
+    const int subBuckets = settings_.subBuckets;
+    if (index < subBuckets)
+    {
+        return static_cast<double>(index) * settings_.width;
+    }
+    const std::int64_t exponent = (index - subBuckets) / subBuckets;
+    const std::int64_t sub = (index - subBuckets) % subBuckets;
+    return std::ldexp(static_cast<double>(subBuckets + sub), static_cast<int>(exponent)) * settings_.width;
+}
+
+void Histogram::extendTo(std::int64_t low, std::int64_t high)
+{
+    if (counts_.empty())
+    {
+        firstIndex_ = low;
+        counts_.assign(static_cast<std::size_t>(high - low + 1), 0);
+        return;
+    }
+
+    const std::int64_t lastIndex = firstIndex_ + binCount() - 1;
+    if (low < firstIndex_)
+    {
+        counts_.insert(counts_.begin(), static_cast<std::size_t>(firstIndex_ - low), 0);
+        firstIndex_ = low;
+    }
+    if (high > lastIndex)
+    {
+        counts_.resize(static_cast<std::size_t>(high - firstIndex_ + 1), 0);
+    }
+}
+
+void Histogram::coarsen()
+{
+    // Floor division keeps the grid anchored at 0 for negative indices too.
+    auto half = [](std::int64_t index) { return index >= 0 ? index / 2 : -((1 - index) / 2); };
+
+    width_ *= 2.0;
+    if (counts_.empty())
+    {
+        return;
+    }
+    const std::int64_t first = half(firstIndex_);
+    std::vector<std::int64_t> merged(static_cast<std::size_t>(half(firstIndex_ + binCount() - 1) - first + 1), 0);
+    for (int bin = 0; bin < binCount(); ++bin)
+    {
+        merged[static_cast<std::size_t>(half(firstIndex_ + bin) - first)] += counts_[bin];
+    }
+    firstIndex_ = first;
+    counts_ = std::move(merged);
+}
+
+void Histogram::add(double value)
+{
+    ++count_;
+    if (settings_.binning == HistogramBinning::Fixed)
+    {
+        const int last = binCount() - 1;
+        int bin = static_cast<int>((value - settings_.lower) * binsPerUnit_);
+        if (bin < 0 || value < settings_.lower)
+        {
+            bin = 0;
+        }
+        else if (bin > last)
+        {
+            bin = last;
+        }
+        ++counts_[bin];
+        return;
+    }
+
+    std::int64_t index = gridIndex(value);
+    if (counts_.empty() || index < firstIndex_ || index >= firstIndex_ + binCount())
+    {
+        if (settings_.binning == HistogramBinning::Adaptive)
+        {
+            while (!counts_.empty() &&
+                   std::max(index, firstIndex_ + binCount() - 1) - std::min(index, firstIndex_) >= settings_.bins)
+            {
+                coarsen();
+                index = gridIndex(value);
+            }
+        }
+        extendTo(std::min(index, counts_.empty() ? index : firstIndex_),
+                 std::max(index, counts_.empty() ? index : firstIndex_ + binCount() - 1));
+    }
+    ++counts_[static_cast<std::size_t>(index - firstIndex_)];
+}
+
+void Histogram::merge(const Histogram& other)
+{
+    if (other.count_ == 0)
+    {
+        return;
+    }
+    if (count_ == 0)
+    {
+        *this = other;
+        return;
+    }
+    count_ += other.count_;
+    if (settings_.binning == HistogramBinning::Fixed)
+    {
+        for (std::size_t bin = 0; bin < counts_.size() && bin < other.counts_.size(); ++bin)
+        {
+            counts_[bin] += other.counts_[bin];
+        }
+        return;
+    }
+
+    Histogram source = other;
+    if (settings_.binning == HistogramBinning::Adaptive)
+    {
+        while (width_ < source.width_)
+        {
+            coarsen();
+        }
+        while (source.width_ < width_)
+        {
+            source.coarsen();
+        }
+        while (std::max(firstIndex_ + binCount(), source.firstIndex_ + source.binCount()) -
+                   std::min(firstIndex_, source.firstIndex_) > settings_.bins)
+        {
+            coarsen();
+            source.coarsen();
+        }
+    }
+
+    extendTo(std::min(firstIndex_, source.firstIndex_),
+             std::max(firstIndex_ + binCount(), source.firstIndex_ + source.binCount()) - 1);
+    for (int bin = 0; bin < source.binCount(); ++bin)
+    {
+        counts_[static_cast<std::size_t>(source.firstIndex_ + bin - firstIndex_)] += source.counts_[bin];
+    }
+}
+
+double Histogram::binStart(int bin) const
+{
+    if (settings_.binning == HistogramBinning::Fixed)
+    {
+        return settings_.lower + (settings_.upper - settings_.lower) * bin / binCount();
+    }
+    return gridStart(firstIndex_ + bin);
+}
+
+double Histogram::binEnd(int bin) const
+{
+    if (settings_.binning == HistogramBinning::Fixed)
+    {
+        return bin == binCount() - 1 ? settings_.upper : binStart(bin + 1);
+    }
+    return gridStart(firstIndex_ + bin + 1);
+}
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, int maxBins)
+    : relativeAccuracy_(relativeAccuracy),
+      gamma_((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy)),
+      inverseLogGamma_(1.0 / std::log((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy))),
+      maxBins_(std::max(1, maxBins))
+{
+}
+
+int QuantileSketch::bucketIndex(double value) const
+{
+    return static_cast<int>(std::ceil(std::log(value) * inverseLogGamma_));
+}
+
+double QuantileSketch::bucketValue(int index) const
+{
+    // Midpoint (in relative terms) of the bucket (gamma^(index-1), gamma^index].
+    return 2.0 * std::pow(gamma_, index) / (gamma_ + 1.0);
+}
+
+int QuantileSketch::collapsedIndex(int index) const
+{
+    // Buckets more than maxBins_ below the highest one are folded into the lowest kept bucket.
+    if (counts_.empty())
+    {
+        return index;
+    }
+    const int maxIndex = minIndex_ + static_cast<int>(counts_.size()) - 1;
+    return std::max(index, maxIndex - maxBins_ + 1);
+}
+
+void QuantileSketch::extendTo(int index)
+{
+    if (counts_.empty())
+    {
+        minIndex_ = index;
+        counts_.assign(1, 0);
+        return;
+    }
+
+    const int maxIndex = minIndex_ + static_cast<int>(counts_.size()) - 1;
+    if (index < minIndex_)
+    {
+        counts_.insert(counts_.begin(), static_cast<std::size_t>(minIndex_ - index), 0);
+        minIndex_ = index;
+    }
+    else if (index > maxIndex)
+    {
+        counts_.resize(static_cast<std::size_t>(index - minIndex_ + 1), 0);
+    }
+
+    // Keep at most maxBins_ buckets by folding the lowest ones into the first kept bucket.
+    const int excess = static_cast<int>(counts_.size()) - maxBins_;
+    if (excess > 0)
+    {
+        std::int64_t folded = 0;
+        for (int bin = 0; bin <= excess; ++bin)
+        {
+            folded += counts_[bin];
+        }
+        counts_.erase(counts_.begin(), counts_.begin() + excess);
+        counts_[0] = folded;
+        minIndex_ += excess;
+    }
+}
+
+void QuantileSketch::add(double value)
+{
+    ++count_;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+
+    if (value <= kMinIndexable)
+    {
+        ++zeroCount_;
+        return;
+    }
+
+    const int index = collapsedIndex(bucketIndex(value));
+    extendTo(index);
+    ++counts_[index - minIndex_];
+}
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+    if (other.count_ == 0)
+    {
+        return;
+    }
+
+    count_ += other.count_;
+    zeroCount_ += other.zeroCount_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+
+    if (other.counts_.empty())
+    {
+        return;
+    }
+
+    const int otherMax = other.minIndex_ + static_cast<int>(other.counts_.size()) - 1;
+    extendTo(otherMax);
+    for (std::size_t bin = 0; bin < other.counts_.size(); ++bin)
+    {
+        const int index = collapsedIndex(other.minIndex_ + static_cast<int>(bin));
+        extendTo(index);
+        counts_[index - minIndex_] += other.counts_[bin];
+    }
+}
+
+double QuantileSketch::quantile(double q) const
+{
+    if (count_ == 0)
+    {
+        return 0.0;
+    }
+
+    q = std::min(1.0, std::max(0.0, q));
+    const double rank = q * static_cast<double>(count_ - 1);
+
+    double value = 0.0;
+    std::int64_t cumulative = zeroCount_;
+    if (static_cast<double>(cumulative) > rank)
+    {
+        value = 0.0;
+    }
+    else
+    {
+        value = max_;
+        for (std::size_t bin = 0; bin < counts_.size(); ++bin)
+        {
+            cumulative += counts_[bin];
+            if (static_cast<double>(cumulative) > rank)
+            {
+                value = bucketValue(minIndex_ + static_cast<int>(bin));
+                break;
+            }
+        }
+    }
+    return std::min(max_, std::max(min_, value));
+}
+
+double QuantileSketch::cumulativeProbability(double value) const
+{
+    if (count_ == 0)
+    {
+        return 0.0;
+    }
+    if (value >= max_)
+    {
+        return 1.0;
+    }
+    if (value < min_)
+    {
+        return 0.0;
+    }
+
+    std::int64_t below = value >= 0.0 ? zeroCount_ : 0;
+    if (value > kMinIndexable)
+    {
+        // Whole buckets up to and including the one that contains `value`.
+        const int lastIndex = bucketIndex(value) - minIndex_;
+        for (int bin = 0; bin <= lastIndex && bin < static_cast<int>(counts_.size()); ++bin)
+        {
+            below += counts_[bin];
+        }
+    }
+    return static_cast<double>(below) / static_cast<double>(count_);
+}
+
+CriticalityStatistics::CriticalityStatistics(std::vector<int> durationReferences, int completionReference)
+    : durationReferences_(std::move(durationReferences)),
+      completionReference_(completionReference),
+      criticalCounts_(durationReferences_.size(), 0),
+      durationSums_(durationReferences_.size(), 0),
+      durationSquares_(durationReferences_.size(), 0),
+      crossSums_(durationReferences_.size(), 0)
+{
+}
+
+void CriticalityStatistics::addSamples(const int* durations, int stride, const int* completions, int count)
+{
+    constexpr int kMaxBatch = 64;
+    std::int64_t totals[kMaxBatch];
+
+    for (int first = 0; first < count; first += kMaxBatch)
+    {
+        const int batch = std::min(kMaxBatch, count - first);
+        for (int k = 0; k < batch; ++k)
+        {
+            totals[k] = completions[first + k] - completionReference_;
+            completionSum_ += totals[k];
+            completionSquares_ += totals[k] * totals[k];
+        }
+        samples_ += batch;
+
+        // Inner loop over the samples of one slot, so lane-batched input is read contiguously.
+        const int slots = slotCount();
+        for (int slot = 0; slot < slots; ++slot)
+        {
+            const int* values = durations + static_cast<std::size_t>(slot) * stride + first;
+            const std::int64_t reference = durationReferences_[slot];
+            std::int64_t sum = 0;
+            std::int64_t squares = 0;
+            std::int64_t cross = 0;
+            for (int k = 0; k < batch; ++k)
+            {
+                const std::int64_t duration = values[k] - reference;
+                sum += duration;
+                squares += duration * duration;
+                cross += duration * totals[k];
+            }
+            durationSums_[slot] += sum;
+            durationSquares_[slot] += squares;
+            crossSums_[slot] += cross;
+        }
+    }
+}
+
+void CriticalityStatistics::merge(const CriticalityStatistics& other)
+{
+    samples_ += other.samples_;
+    completionSum_ += other.completionSum_;
+    completionSquares_ += other.completionSquares_;
+    for (int slot = 0; slot < slotCount(); ++slot)
+    {
+        criticalCounts_[slot] += other.criticalCounts_[slot];
+        durationSums_[slot] += other.durationSums_[slot];
+        durationSquares_[slot] += other.durationSquares_[slot];
+        crossSums_[slot] += other.crossSums_[slot];
+    }
+}
+
+double CriticalityStatistics::criticality(int slot) const
+{
+    return samples_ > 0 ? static_cast<double>(criticalCounts_[slot]) / static_cast<double>(samples_) : 0.0;
+}
+
+double CriticalityStatistics::cruciality(int slot) const
+{
+    if (samples_ == 0)
+    {
+        return 0.0;
+    }
+
+    const double n = static_cast<double>(samples_);
+    const double durationMean = static_cast<double>(durationSums_[slot]) / n;
+    const double completionMean = static_cast<double>(completionSum_) / n;
+    const double covariance = static_cast<double>(crossSums_[slot]) / n - durationMean * completionMean;
+    const double durationVariance = static_cast<double>(durationSquares_[slot]) / n - durationMean * durationMean;
+    const double completionVariance = static_cast<double>(completionSquares_) / n - completionMean * completionMean;
+
+    // A constant duration (or completion time) has no correlation to report.
+    if (durationVariance <= 0.0 || completionVariance <= 0.0)
+    {
+        return 0.0;
+    }
+    return std::max(-1.0, std::min(1.0, covariance / std::sqrt(durationVariance * completionVariance)));
+}
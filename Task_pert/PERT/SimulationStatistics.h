@@ -0,0 +1,207 @@
+#ifndef SIMULATION_STATISTICS_H
+#define SIMULATION_STATISTICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Welford accumulator for completion times. Partial accumulators merge with
+// Chan's pairwise update, so parallel runs combine without sharing state.
+struct RunningStatistics
+{
+    std::int64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0; // sum of squared deviations from the mean
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+
+    void add(double value)
+    {
+        ++count;
+        const double delta = value - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (value - mean);
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    void merge(const RunningStatistics& other)
+    {
+        if (other.count == 0)
+        {
+            return;
+        }
+        if (count == 0)
+        {
+            *this = other;
+            return;
+        }
+
+        const std::int64_t combined = count + other.count;
+        const double delta = other.mean - mean;
+        const double otherWeight = static_cast<double>(other.count) / static_cast<double>(combined);
+        mean += delta * otherWeight;
+        m2 += other.m2 + delta * delta * static_cast<double>(count) * otherWeight;
+        count = combined;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+
+    // Population variance, matching the divisor used by PERTSimulation.
+    double variance() const
+    {
+        return count > 0 ? m2 / static_cast<double>(count) : 0.0;
+    }
+
+    double standardDeviation() const
+    {
+        return std::sqrt(variance());
+    }
+};
+
+enum class HistogramBinning
+{
+    Fixed,    // `bins` equal-width bins over [lower, upper]
+    Adaptive, // equal-width bins on a grid anchored at 0; the width doubles while more than `bins` are needed
+    LogLinear // HDR-style: bins of `width` up to width * subBuckets, then subBuckets bins per power of two
+};
+
+struct HistogramSettings
+{
+    HistogramBinning binning = HistogramBinning::Adaptive;
+    int bins = 20;       // Fixed: bin count; Adaptive: most bins kept
+    double lower = 0.0;  // Fixed: range of the bins; the simulation substitutes the
+    double upper = 0.0;  //   smallest to largest possible completion time when lower >= upper
+    double width = 1.0;  // Adaptive: starting bin width; LogLinear: width of the finest bins
+    int subBuckets = 32; // LogLinear: bins per power of two (bin width <= value / subBuckets)
+};
+
+// Completion-time histogram filled while sampling. Bin edges lie on a grid
+// that depends only on the settings, so partial histograms from different
+// threads (or runs with the same settings) merge by adding counts and can be
+// overlaid bin for bin:
+//   - Fixed: values outside [lower, upper] land in the first/last bin;
+//   - Adaptive: widths are the starting width times a power of two, and a
+//     merge happens at the coarser of the two, so the result is the same
+//     however the samples were split;
+//   - LogLinear: relative resolution is fixed and storage grows only with the
+//     logarithm of the value range.
+class Histogram
+{
+public:
+    Histogram() = default;
+    explicit Histogram(const HistogramSettings& settings);
+
+    void add(double value);
+    void merge(const Histogram& other);
+
+    HistogramBinning binning() const { return settings_.binning; }
+    std::int64_t count() const { return count_; }
+    int binCount() const { return static_cast<int>(counts_.size()); }
+    double binStart(int bin) const;
+    double binEnd(int bin) const;
+    const std::vector<std::int64_t>& counts() const { return counts_; }
+
+private:
+    std::int64_t gridIndex(double value) const; // Adaptive / LogLinear
+    double gridStart(std::int64_t index) const;
+    void extendTo(std::int64_t low, std::int64_t high);
+    void coarsen();
+
+    HistogramSettings settings_;
+    double binsPerUnit_ = 0.0;     // Fixed
+    double width_ = 0.0;           // Adaptive: current bin width
+    std::int64_t firstIndex_ = 0;  // grid index of counts_[0] (Adaptive / LogLinear)
+    std::int64_t count_ = 0;
+    std::vector<std::int64_t> counts_;
+};
+
+// Mergeable quantile sketch with relative-accuracy guarantee (DDSketch-style
+// logarithmic buckets). For non-negative data:
+//   - quantile(q) is within relativeAccuracy * v of the true q-quantile v;
+//   - cumulativeProbability(t) equals the exact P(T <= t') for some t' with
+//     t <= t' <= t * (1 + relativeAccuracy) / (1 - relativeAccuracy); with the
+//     default accuracy this is exact for integer completion times up to ~500.
+// Memory is bounded by maxBins counters whatever the number of samples; if the
+// value range needs more, the lowest buckets are collapsed (losing accuracy only
+// in the far lower tail). Merging only adds integer counts, so the merged sketch
+// does not depend on how samples were split across threads.
+class QuantileSketch
+{
+public:
+    QuantileSketch()
+        : QuantileSketch(0.001)
+    {
+    }
+
+    explicit QuantileSketch(double relativeAccuracy, int maxBins = 16384);
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+
+    std::int64_t count() const { return count_; }
+    double relativeAccuracy() const { return relativeAccuracy_; }
+
+    double quantile(double q) const;                   // q in [0, 1]
+    double cumulativeProbability(double value) const;  // fraction of samples <= value
+
+private:
+    int bucketIndex(double value) const;
+    int collapsedIndex(int index) const;
+    double bucketValue(int index) const;
+    void extendTo(int index);
+
+    double relativeAccuracy_;
+    double gamma_;
+    double inverseLogGamma_;
+    int maxBins_;
+
+    std::int64_t count_ = 0;
+    std::int64_t zeroCount_ = 0;  // values too small to index (<= kMinIndexable)
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+    int minIndex_ = 0;            // bucket index of counts_[0]
+    std::vector<std::int64_t> counts_;
+};
+
+// Per-task criticality and cruciality tallies, indexed by an arbitrary slot
+// (the engine uses topological positions). Every sample adds one to the
+// counts of the tasks on its critical chain and updates the sums of duration,
+// squared duration and duration x completion. The sums are taken relative to
+// fixed reference values, which keeps them small and exact in 64-bit integers,
+// so merging partial tallies is order-independent.
+class CriticalityStatistics
+{
+public:
+    CriticalityStatistics() = default;
+    CriticalityStatistics(std::vector<int> durationReferences, int completionReference);
+
+    // Adds `count` samples stored slot-major: the durations of slot s are
+    // durations[s * stride + 0 .. count - 1] (stride 1 for a single sample,
+    // the lane count for lane-batched layouts).
+    void addSamples(const int* durations, int stride, const int* completions, int count);
+    void addCritical(int slot) { ++criticalCounts_[slot]; }
+    void merge(const CriticalityStatistics& other);
+
+    int slotCount() const { return static_cast<int>(criticalCounts_.size()); }
+    std::int64_t samples() const { return samples_; }
+
+    double criticality(int slot) const; // fraction of samples in which the task was critical
+    double cruciality(int slot) const;  // Pearson correlation of task duration and completion time
+
+private:
+    std::vector<int> durationReferences_;
+    int completionReference_ = 0;
+
+    std::int64_t samples_ = 0;
+    std::int64_t completionSum_ = 0;
+    std::int64_t completionSquares_ = 0;
+    std::vector<std::int64_t> criticalCounts_;
+    std::vector<std::int64_t> durationSums_;
+    std::vector<std::int64_t> durationSquares_;
+    std::vector<std::int64_t> crossSums_;
+};
+
+#endif // SIMULATION_STATISTICS_H
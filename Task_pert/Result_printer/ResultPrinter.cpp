@@ -1,9 +1,12 @@
 #include "ResultPrinter.h"
+#include "NormalDistribution.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <unordered_set>
@@ -15,46 +18,7 @@
 
 namespace
 {
-double normalCDF(double z)
-{
-    return 0.5 * (1.0 + std::erf(z / std::sqrt(2.0)));
-}
-
-double normalInvCDF(double p)
-{
-    if (p > 0.999)
-    {
-        return 3.29;
-    }
-    if (p > 0.99)
-    {
-        return 2.33;
-    }
-    if (p < 0.001)
-    {
-        return -3.29;
-    }
-    if (p < 0.01)
-    {
-        return -2.33;
-    }
-
-    double low = -8.0;
-    double high = 8.0;
-    for (int i = 0; i < 100; ++i)
-    {
-        const double mid = (low + high) / 2.0;
-        if (normalCDF(mid) < p)
-        {
-            low = mid;
-        }
-        else
-        {
-            high = mid;
-        }
-    }
-    return high;
-}
+constexpr double kProbabilityGrid[] = {0.50, 0.60, 0.70, 0.80, 0.85, 0.90, 0.95, 0.975, 0.99, 0.995, 0.999, 0.9999};
 
 constexpr char RESET_COLOR[] = "\033[0m";
 constexpr char TITLE_COLOR[] = "\033[1;36m";
@@ -88,6 +52,36 @@ void applyColor(std::ostream& output, bool enabled, const char* color)
     }
 }
 
+const char* statusLabel(BatchStatus status)
+{
+    switch (status)
+    {
+    case BatchStatus::Passed:
+        return "PASS";
+    case BatchStatus::Failed:
+        return "FAIL";
+    case BatchStatus::Unchecked:
+        return "----";
+    case BatchStatus::Error:
+        return "ERROR";
+    }
+    return "";
+}
+
+const char* formatLabel(ProjectFormat format)
+{
+    switch (format)
+    {
+    case ProjectFormat::Cpm:
+        return "CPM";
+    case ProjectFormat::Pert:
+        return "PERT";
+    case ProjectFormat::Unknown:
+        break;
+    }
+    return "?";
+}
+
 std::string taskLabel(int id)
 {
     if (id <= 0)
@@ -106,64 +100,27 @@ std::string taskLabel(int id)
     return label;
 }
 
-void printHistogram(const PERTSimulation& simulation,
-                    std::ostream& output,
-                    bool useColor)
+void printHistogramBins(const std::vector<std::int64_t>& counts,
+                        const std::vector<double>& edges,
+                        std::ostream& output,
+                        bool useColor)
 {
-    if (simulation.completionTimes.empty())
-    {
-        return;
-    }
-
-    const double minValue = simulation.minDuration;
-    const double maxValue = simulation.maxDuration;
-    const double range = maxValue - minValue;
-    const double epsilon = std::numeric_limits<double>::epsilon() * std::max(1.0, std::abs(minValue));
-
-    // Handle the degenerate case where every simulation finished at the same time.
-    if (range <= epsilon)
-    {
-        applyColor(output, useColor, LABEL_COLOR);
-        output << "  All simulations completed at approximately ";
-        applyColor(output, useColor, VALUE_COLOR);
-        output << std::setprecision(1) << minValue;
-        applyColor(output, useColor, RESET_COLOR);
-        output << '\n';
-        return;
-    }
-
-    constexpr int kBinCount = 20;
     constexpr int kMaxBarWidth = 40;
 
-    std::vector<int> counts(kBinCount, 0);
-    for (double time : simulation.completionTimes)
-    {
-        const double normalized = (time - minValue) / range;
-        int index = static_cast<int>(normalized * kBinCount);
-        if (index < 0)
-        {
-            index = 0;
-        }
-        else if (index >= kBinCount)
-        {
-            index = kBinCount - 1;
-        }
-        ++counts[index];
-    }
-
-    const int maxCount = *std::max_element(counts.begin(), counts.end());
+    const int binCount = static_cast<int>(counts.size());
+    const std::int64_t maxCount = *std::max_element(counts.begin(), counts.end());
     if (maxCount == 0)
     {
         return;
     }
 
     int firstBin = 0;
-    while (firstBin < kBinCount && counts[firstBin] == 0)
+    while (firstBin < binCount && counts[firstBin] == 0)
     {
         ++firstBin;
     }
 
-    int lastBin = kBinCount - 1;
+    int lastBin = binCount - 1;
     while (lastBin > firstBin && counts[lastBin] == 0)
     {
         --lastBin;
@@ -172,12 +129,9 @@ void printHistogram(const PERTSimulation& simulation,
     output << std::setprecision(1);
     for (int i = firstBin; i <= lastBin; ++i)
     {
-        const double binStart = minValue + (range * i) / kBinCount;
-        const double binEnd = (i == kBinCount - 1) ? maxValue : minValue + (range * (i + 1)) / kBinCount;
-
         applyColor(output, useColor, LABEL_COLOR);
-    output << "  [" << std::setw(7) << binStart << ", " << std::setw(7) << binEnd
-               << (i == kBinCount - 1 ? "]" : ")");
+    output << "  [" << std::setw(7) << edges[i] << ", " << std::setw(7) << edges[i + 1]
+               << (i == binCount - 1 ? "]" : ")");
         applyColor(output, useColor, VALUE_COLOR);
         output << " | ";
 
@@ -205,6 +159,42 @@ void printHistogram(const PERTSimulation& simulation,
         applyColor(output, useColor, RESET_COLOR);
     }
 }
+
+void printHistogram(const PERTSimulation& simulation,
+                    std::ostream& output,
+                    bool useColor)
+{
+    if (simulation.histogram.count() == 0)
+    {
+        return;
+    }
+
+    const double minValue = simulation.minDuration;
+    const double maxValue = simulation.maxDuration;
+    const double range = maxValue - minValue;
+    const double epsilon = std::numeric_limits<double>::epsilon() * std::max(1.0, std::abs(minValue));
+
+    // Handle the degenerate case where every simulation finished at the same time.
+    if (range <= epsilon)
+    {
+        applyColor(output, useColor, LABEL_COLOR);
+        output << "  All simulations completed at approximately ";
+        applyColor(output, useColor, VALUE_COLOR);
+        output << std::setprecision(1) << minValue;
+        applyColor(output, useColor, RESET_COLOR);
+        output << '\n';
+        return;
+    }
+
+    const Histogram& histogram = simulation.histogram;
+    std::vector<double> edges;
+    for (int i = 0; i < histogram.binCount(); ++i)
+    {
+        edges.push_back(histogram.binStart(i));
+    }
+    edges.push_back(histogram.binEnd(histogram.binCount() - 1));
+    printHistogramBins(histogram.counts(), edges, output, useColor);
+}
 }
 
 void ResultPrinter::printCPM(const ProjectData& projectData,
@@ -373,7 +363,7 @@ void ResultPrinter::printPERT(const ProjectDataPert& projectData,
     if (result.standardDeviation > 0.0)
     {
         const double zScore = (projectData.target_time - result.expectedDuration) / result.standardDeviation;
-        onTimeProbability = normalCDF(zScore);
+        onTimeProbability = standardNormalCDF(zScore);
     }
     else
     {
@@ -387,7 +377,7 @@ void ResultPrinter::printPERT(const ProjectDataPert& projectData,
     applyColor(output, useColor, RESET_COLOR);
     output << '\n';
 
-    const double zForProbability = normalInvCDF(projectData.target_probability);
+    const double zForProbability = standardNormalQuantile(projectData.target_probability);
     const double timeForProbability = result.expectedDuration + result.standardDeviation * zForProbability;
 
     applyColor(output, useColor, LABEL_COLOR);
@@ -419,8 +409,38 @@ void ResultPrinter::printSimulation(const PERTSimulation& result,
     output << "Schedule statistics (based on " << result.simulations << " simulations):" << '\n';
     applyColor(output, useColor, RESET_COLOR);
 
+    applyColor(output, useColor, LABEL_COLOR);
+    output << "  Random seed: ";
+    applyColor(output, useColor, VALUE_COLOR);
+    output << result.seed << '\n';
+
     output.setf(std::ios::fixed, std::ios::floatfield);
 
+    if (result.targetHalfWidth > 0.0 || result.stopReason != StopReason::SampleLimit)
+    {
+        applyColor(output, useColor, LABEL_COLOR);
+        output << "  Stopped by: ";
+        applyColor(output, useColor, VALUE_COLOR);
+        switch (result.stopReason)
+        {
+        case StopReason::SampleLimit:
+            output << "sample limit";
+            break;
+        case StopReason::PrecisionReached:
+            output << "precision reached";
+            break;
+        case StopReason::TimeBudget:
+            output << "time budget";
+            break;
+        }
+        if (result.targetHalfWidth > 0.0)
+        {
+            output << " (CI half-width " << std::setprecision(4) << result.achievedHalfWidth
+                   << ", target " << result.targetHalfWidth << ')';
+        }
+        output << '\n';
+    }
+
     applyColor(output, useColor, LABEL_COLOR);
     output << "  Expected duration: ";
     applyColor(output, useColor, VALUE_COLOR);
@@ -437,15 +457,7 @@ void ResultPrinter::printSimulation(const PERTSimulation& result,
     output << std::setprecision(1) << targetTime << '\n';
 
     // Calculate probability to meet target time
-    double onTimeProbability = 0.0;
-    for (double time : result.completionTimes)
-    {
-        if (time <= targetTime)
-        {
-            onTimeProbability += 1.0;
-        }
-    }
-    onTimeProbability /= result.simulations;
+    const double onTimeProbability = result.getProbabilityWithin(targetTime);
 
     applyColor(output, useColor, LABEL_COLOR);
     output << "  Probability to meet target: ";
@@ -465,7 +477,16 @@ void ResultPrinter::printSimulation(const PERTSimulation& result,
     applyColor(output, useColor, RESET_COLOR);
     output << '\n';
 
-    if (!result.completionTimes.empty())
+    if (result.streaming)
+    {
+        applyColor(output, useColor, LABEL_COLOR);
+        output << "  (streaming mode: probabilities and percentiles within "
+               << std::setprecision(2) << result.sketch.relativeAccuracy() * 100.0 << "% relative error)" << '\n';
+        applyColor(output, useColor, RESET_COLOR);
+        output << '\n';
+    }
+
+    if (!result.completionTimes.empty() || result.streaming)
     {
         applyColor(output, useColor, SECTION_COLOR);
         output << "Duration histogram:" << '\n';
@@ -477,3 +498,358 @@ void ResultPrinter::printSimulation(const PERTSimulation& result,
     output.flags(originalFlags);
     output.precision(originalPrecision);
 }
+
+void ResultPrinter::printProbabilityTable(const PERTResult& result,
+                                          const ClarkEstimate* clark,
+                                          const PERTSimulation* simulation,
+                                          std::ostream& output)
+{
+    constexpr int kRows = static_cast<int>(sizeof(kProbabilityGrid) / sizeof(kProbabilityGrid[0]));
+
+    const bool useColor = streamSupportsColor(output);
+    const auto originalFlags = output.flags();
+    const auto originalPrecision = output.precision();
+    const std::string separator(30 + (clark != nullptr ? 16 : 0) + (simulation != nullptr ? 16 : 0), '-');
+
+    // Every column in one pass: batched quantile calls and one percentile query.
+    double z[kRows];
+    standardNormalQuantiles(kProbabilityGrid, z, kRows);
+    std::vector<double> percentiles(std::begin(kProbabilityGrid), std::end(kProbabilityGrid));
+    for (double& percentile : percentiles)
+    {
+        percentile *= 100.0;
+    }
+    const std::vector<double> clarkTimes = clark != nullptr ? clark->getPercentiles(percentiles) : std::vector<double>();
+    const std::vector<double> simulated =
+        simulation != nullptr ? simulation->getPercentiles(percentiles) : std::vector<double>();
+
+    applyColor(output, useColor, SECTION_COLOR);
+    output << "Required project time by probability:" << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << separator << '\n';
+
+    applyColor(output, useColor, HEADER_COLOR);
+    output << std::left << std::setw(14) << "Probability" << std::right << std::setw(16) << "Analytic (PERT)";
+    if (clark != nullptr)
+    {
+        output << std::setw(16) << (clark->clipped ? "Clark*" : "Clark");
+    }
+    if (simulation != nullptr)
+    {
+        output << std::setw(16) << "Simulation";
+    }
+    output << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << separator << '\n';
+
+    output.setf(std::ios::fixed, std::ios::floatfield);
+    for (int row = 0; row < kRows; ++row)
+    {
+        applyColor(output, useColor, LABEL_COLOR);
+        output << std::left << std::setw(14) << std::setprecision(2) << kProbabilityGrid[row] * 100.0;
+        applyColor(output, useColor, VALUE_COLOR);
+        output << std::right << std::setw(16) << result.expectedDuration + result.standardDeviation * z[row];
+        if (clark != nullptr)
+        {
+            // A percentile clipped to the support is a bound, not an estimate.
+            const bool atBound = clarkTimes[row] <= clark->lowerBound || clarkTimes[row] >= clark->upperBound;
+            if (clark->clipped && atBound)
+            {
+                output << std::setw(16) << "n/a";
+            }
+            else
+            {
+                output << std::setw(16) << clarkTimes[row];
+            }
+        }
+        if (simulation != nullptr)
+        {
+            output << std::setw(16) << simulated[row];
+        }
+        output << '\n';
+        applyColor(output, useColor, RESET_COLOR);
+    }
+    output << separator << '\n';
+    if (clark != nullptr && clark->clipped)
+    {
+        output << "* Clark's normal puts " << std::setprecision(1) << clark->clippedMass * 100.0
+               << "% of its mass outside [" << std::setprecision(2) << clark->lowerBound << ", "
+               << clark->upperBound << "] (mean " << clark->meanDuration << ", sd " << clark->standardDeviation
+               << "); n/a where its percentile falls outside those bounds.\n";
+    }
+    output << '\n';
+
+    output.flags(originalFlags);
+    output.precision(originalPrecision);
+}
+
+void ResultPrinter::printPaths(const ProjectDataPert& projectData,
+                               const std::vector<ProjectPath<double>>& paths,
+                               double targetTime,
+                               std::ostream& output)
+{
+    constexpr std::size_t kListedTasks = 12; // longer paths show their first and last tasks
+
+    const bool useColor = streamSupportsColor(output);
+    const auto originalFlags = output.flags();
+    const auto originalPrecision = output.precision();
+    const std::string separator(74, '-');
+
+    applyColor(output, useColor, SECTION_COLOR);
+    output << "Longest paths (" << paths.size() << ", expected durations):" << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << separator << '\n';
+
+    applyColor(output, useColor, HEADER_COLOR);
+    output << std::left
+           << std::setw(4) << "#"
+           << std::setw(10) << "Length"
+           << std::setw(10) << "Slack"
+           << std::setw(10) << "Std Dev"
+           << std::setw(10) << "P(on time)"
+           << "  Tasks" << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << separator << '\n';
+
+    output.setf(std::ios::fixed, std::ios::floatfield);
+    for (std::size_t rank = 0; rank < paths.size(); ++rank)
+    {
+        const ProjectPath<double>& path = paths[rank];
+        double variance = 0.0;
+        for (int id : path.tasks)
+        {
+            variance += projectData.tasks.at(id).variance;
+        }
+        const double deviation = std::sqrt(variance);
+        const double onTime = deviation > 0.0 ? standardNormalCDF((targetTime - path.length) / deviation)
+                                              : (path.length <= targetTime ? 1.0 : 0.0);
+
+        applyColor(output, useColor, std::abs(path.slack) < 1e-6 ? CRITICAL_COLOR : VALUE_COLOR);
+        output << std::left << std::setw(4) << rank + 1 << std::setprecision(2)
+               << std::setw(10) << path.length
+               << std::setw(10) << path.slack
+               << std::setw(10) << deviation
+               << std::setw(10) << std::setprecision(4) << onTime << "  ";
+        for (std::size_t k = 0; k < path.tasks.size(); ++k)
+        {
+            if (path.tasks.size() > kListedTasks && k == kListedTasks / 2)
+            {
+                output << "... -> ";
+                k = path.tasks.size() - kListedTasks / 2;
+            }
+            output << taskLabel(path.tasks[k]) << (k + 1 < path.tasks.size() ? " -> " : "");
+        }
+        output << '\n';
+        applyColor(output, useColor, RESET_COLOR);
+    }
+    output << separator << '\n' << '\n';
+
+    output.flags(originalFlags);
+    output.precision(originalPrecision);
+}
+
+void ResultPrinter::printOverrun(const OverrunEstimate& estimate,
+                                 std::ostream& output)
+{
+    const bool useColor = streamSupportsColor(output);
+    const auto originalFlags = output.flags();
+    const auto originalPrecision = output.precision();
+
+    applyColor(output, useColor, SECTION_COLOR);
+    if (estimate.exact)
+    {
+        output << "Overrun probability (exact, the deadline is outside the possible completion times):" << '\n';
+    }
+    else
+    {
+        output << "Overrun probability (importance sampling, " << estimate.simulations << " samples + "
+               << estimate.tuningSimulations << " tuning in " << estimate.iterations << " iterations):" << '\n';
+    }
+    applyColor(output, useColor, RESET_COLOR);
+
+    output.setf(std::ios::fixed, std::ios::floatfield);
+
+    applyColor(output, useColor, LABEL_COLOR);
+    output << "  Deadline: ";
+    applyColor(output, useColor, VALUE_COLOR);
+    output << std::setprecision(1) << estimate.deadline << " (completion between " << estimate.earliestCompletion
+           << " and " << estimate.latestCompletion << ")" << '\n';
+
+    if (estimate.exact)
+    {
+        applyColor(output, useColor, LABEL_COLOR);
+        output << "  P(T > deadline): ";
+        applyColor(output, useColor, VALUE_COLOR);
+        output << std::setprecision(0) << estimate.probability << '\n';
+        applyColor(output, useColor, RESET_COLOR);
+        output << '\n';
+
+        output.flags(originalFlags);
+        output.precision(originalPrecision);
+        return;
+    }
+
+    output.setf(std::ios::scientific, std::ios::floatfield);
+
+    applyColor(output, useColor, LABEL_COLOR);
+    output << "  P(T > deadline): ";
+    applyColor(output, useColor, VALUE_COLOR);
+    output << std::setprecision(4) << estimate.probability
+           << " +/- " << std::setprecision(2) << estimate.standardError << '\n';
+
+    output.setf(std::ios::fixed, std::ios::floatfield);
+
+    applyColor(output, useColor, LABEL_COLOR);
+    output << "  Effective sample size: ";
+    applyColor(output, useColor, VALUE_COLOR);
+    output << std::setprecision(0) << estimate.effectiveSampleSize << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << '\n';
+
+    output.flags(originalFlags);
+    output.precision(originalPrecision);
+}
+
+void ResultPrinter::printCriticality(const ProjectDataPert& projectData,
+                                     const PERTSimulation& result,
+                                     std::ostream& output)
+{
+    if (result.criticalityIndex.size() != projectData.tasks.size())
+    {
+        return;
+    }
+
+    const bool useColor = streamSupportsColor(output);
+    const auto originalFlags = output.flags();
+    const auto originalPrecision = output.precision();
+    const std::string separator(38, '-');
+
+    applyColor(output, useColor, SECTION_COLOR);
+    output << "Task criticality (based on " << result.simulations << " simulations):" << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << separator << '\n';
+
+    applyColor(output, useColor, HEADER_COLOR);
+    output << std::left
+           << std::setw(6) << "ID"
+           << std::setw(16) << "Criticality"
+           << std::setw(16) << "Cruciality"
+           << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << separator << '\n';
+
+    output.setf(std::ios::fixed, std::ios::floatfield);
+    output << std::setprecision(4);
+
+    // Tasks are indexed like the compiled graph, i.e. in ascending id order.
+    std::size_t index = 0;
+    for (const auto& [id, task] : projectData.tasks)
+    {
+        const double criticality = result.criticalityIndex[index];
+        applyColor(output, useColor, criticality >= 0.5 ? CRITICAL_COLOR : VALUE_COLOR);
+        output << std::setw(6) << taskLabel(id)
+               << std::setw(16) << criticality
+               << std::setw(16) << result.cruciality[index]
+               << '\n';
+        applyColor(output, useColor, RESET_COLOR);
+        ++index;
+    }
+
+    output << separator << '\n' << '\n';
+
+    output.flags(originalFlags);
+    output.precision(originalPrecision);
+}
+
+void ResultPrinter::printBatch(const BatchSummary& summary,
+                               std::ostream& output)
+{
+    const bool useColor = streamSupportsColor(output);
+    const auto originalFlags = output.flags();
+    const auto originalPrecision = output.precision();
+    const std::string separator(86, '-');
+
+    applyColor(output, useColor, TITLE_COLOR);
+    output << '\n' << "=== Batch Analysis Result ===" << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << separator << '\n';
+
+    applyColor(output, useColor, HEADER_COLOR);
+    output << std::left
+           << std::setw(7) << "Status"
+           << std::setw(6) << "Kind"
+           << std::setw(30) << "File"
+           << std::right
+           << std::setw(9) << "Tasks"
+           << std::setw(12) << "Duration"
+           << std::setw(8) << "Checks"
+           << std::setw(14) << "Time [ms]"
+           << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << separator << '\n';
+
+    output.setf(std::ios::fixed, std::ios::floatfield);
+    double loadMilliseconds = 0.0;
+    double analysisMilliseconds = 0.0;
+    for (const BatchItem& item : summary.items)
+    {
+        loadMilliseconds += item.loadMilliseconds;
+        analysisMilliseconds += item.analysisMilliseconds;
+
+        const bool failed = item.status == BatchStatus::Failed || item.status == BatchStatus::Error;
+        applyColor(output, useColor, failed ? CRITICAL_COLOR : item.status == BatchStatus::Passed ? MATCH_COLOR : VALUE_COLOR);
+        output << std::left << std::setw(7) << statusLabel(item.status);
+        applyColor(output, useColor, VALUE_COLOR);
+        output << std::setw(6) << formatLabel(item.format)
+               << std::setw(30) << item.file
+               << std::right
+               << std::setw(9) << item.taskCount
+               << std::setw(12) << std::setprecision(item.format == ProjectFormat::Pert ? 2 : 0) << item.duration
+               << std::setw(8) << item.checkedValues
+               << std::setw(14) << std::setprecision(3) << item.loadMilliseconds + item.analysisMilliseconds
+               << '\n';
+        if (!item.message.empty())
+        {
+            applyColor(output, useColor, LABEL_COLOR);
+            output << "       " << item.message << '\n';
+        }
+        applyColor(output, useColor, RESET_COLOR);
+    }
+    output << separator << '\n';
+
+    applyColor(output, useColor, SECTION_COLOR);
+    output << "Summary (" << summary.items.size() << " files, " << summary.threadCount << " threads):" << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+
+    applyColor(output, useColor, LABEL_COLOR);
+    output << "  Passed / failed / unchecked / errors: ";
+    applyColor(output, useColor, VALUE_COLOR);
+    output << summary.count(BatchStatus::Passed) << " / " << summary.count(BatchStatus::Failed) << " / "
+           << summary.count(BatchStatus::Unchecked) << " / " << summary.count(BatchStatus::Error) << '\n';
+
+    output << std::setprecision(3);
+    applyColor(output, useColor, LABEL_COLOR);
+    output << "  Load + compile (summed over files): ";
+    applyColor(output, useColor, VALUE_COLOR);
+    output << loadMilliseconds << " ms" << '\n';
+
+    applyColor(output, useColor, LABEL_COLOR);
+    output << "  Analysis (summed over files): ";
+    applyColor(output, useColor, VALUE_COLOR);
+    output << analysisMilliseconds << " ms" << '\n';
+
+    applyColor(output, useColor, LABEL_COLOR);
+    output << "  Wall time: ";
+    applyColor(output, useColor, VALUE_COLOR);
+    output << summary.wallMilliseconds << " ms";
+    if (summary.wallMilliseconds > 0.0)
+    {
+        output << " (" << std::setprecision(1) << summary.items.size() * 1000.0 / summary.wallMilliseconds << " files/s)";
+    }
+    output << '\n';
+    applyColor(output, useColor, RESET_COLOR);
+    output << '\n';
+
+    output.flags(originalFlags);
+    output.precision(originalPrecision);
+}
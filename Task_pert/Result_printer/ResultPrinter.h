@@ -4,10 +4,12 @@
 #include <iosfwd>
 #include <map>
 
+#include "BatchRunner.h"
 #include "CPMCalculator.h"
 #include "DataLoader.h"
 #include "DataLoader_pert.h"
 #include "PERTCalculator.h"
+#include "PathEnumerator.h"
 
 class ResultPrinter
 {
@@ -24,6 +26,33 @@ public:
                                           double targetTime,
                                           double targetProbability,
                                           std::ostream& output);
+
+    // Project time needed for a grid of probabilities (50% ... 99.99%) from
+    // the normal approximation of `result` and, when given, from the Clark
+    // estimate and from `simulation`.
+    static void printProbabilityTable(const PERTResult& result,
+                                      const ClarkEstimate* clark,
+                                      const PERTSimulation* simulation,
+                                      std::ostream& output);
+
+    // Longest paths by expected duration (PathEnumerator) with the normal
+    // approximation of each one finishing by `targetTime`.
+    static void printPaths(const ProjectDataPert& projectData,
+                           const std::vector<ProjectPath<double>>& paths,
+                           double targetTime,
+                           std::ostream& output);
+
+    static void printOverrun(const OverrunEstimate& estimate,
+                             std::ostream& output);
+
+    // Per-task criticality/cruciality table; needs SimulationOptions::trackCriticality.
+    static void printCriticality(const ProjectDataPert& projectData,
+                                 const PERTSimulation& result,
+                                 std::ostream& output);
+
+    // One line per file (failures with their first mismatch) and the totals.
+    static void printBatch(const BatchSummary& summary,
+                           std::ostream& output);
 };
 
 #endif // RESULT_PRINTER_H
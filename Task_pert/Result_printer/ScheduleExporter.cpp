@@ -0,0 +1,349 @@
+#include "ScheduleExporter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t kMaxRowBytes = 512; // longest CSV / JSON row with slack
+
+class OutputBuffer
+{
+public:
+    explicit OutputBuffer(std::ostream& output) : output_(output), buffer_(ScheduleExporter::kBufferSize) {}
+
+    // Room for `bytes` more, flushing first when the buffer cannot take them.
+    void reserve(std::size_t bytes)
+    {
+        if (used_ + bytes > buffer_.size())
+        {
+            flush();
+        }
+    }
+
+    void text(std::string_view value)
+    {
+        std::memcpy(buffer_.data() + used_, value.data(), value.size());
+        used_ += value.size();
+    }
+
+    void character(char value) { buffer_[used_++] = value; }
+
+    template <typename T>
+    void number(T value)
+    {
+        used_ = static_cast<std::size_t>(std::to_chars(buffer_.data() + used_, buffer_.data() + buffer_.size(), value).ptr -
+                                         buffer_.data());
+    }
+
+    // Raw bytes of any size, padded to the next multiple of 8.
+    void bytes(const void* data, std::size_t size)
+    {
+        const char* source = static_cast<const char*>(data);
+        while (size > 0)
+        {
+            reserve(1);
+            const std::size_t chunk = std::min(size, buffer_.size() - used_);
+            std::memcpy(buffer_.data() + used_, source, chunk);
+            used_ += chunk;
+            source += chunk;
+            size -= chunk;
+            padding_ = (padding_ + chunk) % 8;
+        }
+        if (padding_ != 0)
+        {
+            static const char zeros[8] = {};
+            const std::size_t pad = 8 - padding_;
+            reserve(pad);
+            text(std::string_view(zeros, pad));
+            padding_ = 0;
+        }
+    }
+
+    bool flush()
+    {
+        output_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+        used_ = 0;
+        return static_cast<bool>(output_);
+    }
+
+private:
+    std::ostream& output_;
+    std::vector<char> buffer_;
+    std::size_t used_ = 0;
+    std::size_t padding_ = 0;
+};
+
+// Position on the critical path (1-based) per graph index, 0 when not on it.
+std::vector<int> criticalPositions(const ProjectGraph& graph, const std::vector<int>& criticalPath)
+{
+    std::vector<int> positions(graph.size(), 0);
+    for (std::size_t k = 0; k < criticalPath.size(); ++k)
+    {
+        const int index = graph.indexOf(criticalPath[k]);
+        if (index >= 0)
+        {
+            positions[index] = static_cast<int>(k) + 1;
+        }
+    }
+    return positions;
+}
+
+template <typename T>
+T durationAt(const ProjectGraph& graph, int index)
+{
+    if constexpr (std::is_same_v<T, int>)
+    {
+        return graph.durations()[index];
+    }
+    else
+    {
+        return graph.expectedDurations()[index];
+    }
+}
+
+template <typename T>
+void writeCsv(const ProjectGraph& graph,
+              const ProjectSchedule<T>& schedule,
+              const std::vector<int>& critical,
+              OutputBuffer& out)
+{
+    out.reserve(kMaxRowBytes);
+    out.text("id,duration,early_start,early_finish,late_start,late_finish,slack,critical\n");
+    for (int i = 0; i < graph.size(); ++i)
+    {
+        out.reserve(kMaxRowBytes);
+        out.number(graph.taskId(i));
+        out.character(',');
+        out.number(durationAt<T>(graph, i));
+        for (const std::vector<T>* column : {&schedule.ES, &schedule.EF, &schedule.LS, &schedule.LF, &schedule.slack})
+        {
+            out.character(',');
+            out.number((*column)[i]);
+        }
+        out.character(',');
+        out.number(critical[i]);
+        out.character('\n');
+    }
+}
+
+template <typename T>
+void writeJsonLines(const ProjectGraph& graph,
+                    const ProjectSchedule<T>& schedule,
+                    const std::vector<int>& criticalPath,
+                    double totalDuration,
+                    const double* standardDeviation,
+                    const std::vector<int>& critical,
+                    OutputBuffer& out)
+{
+    out.reserve(kMaxRowBytes);
+    out.text("{\"tasks\":");
+    out.number(graph.size());
+    out.text(",\"duration\":");
+    out.number(totalDuration);
+    if (standardDeviation != nullptr)
+    {
+        out.text(",\"standard_deviation\":");
+        out.number(*standardDeviation);
+    }
+    out.text(",\"critical_path\":[");
+    for (std::size_t k = 0; k < criticalPath.size(); ++k)
+    {
+        out.reserve(kMaxRowBytes);
+        if (k > 0)
+        {
+            out.character(',');
+        }
+        out.number(criticalPath[k]);
+    }
+    out.reserve(kMaxRowBytes);
+    out.text("]}\n");
+
+    static constexpr std::string_view keys[] = {",\"early_start\":", ",\"early_finish\":", ",\"late_start\":",
+                                                ",\"late_finish\":", ",\"slack\":"};
+    for (int i = 0; i < graph.size(); ++i)
+    {
+        out.reserve(kMaxRowBytes);
+        out.text("{\"id\":");
+        out.number(graph.taskId(i));
+        out.text(",\"duration\":");
+        out.number(durationAt<T>(graph, i));
+        const std::vector<T>* columns[] = {&schedule.ES, &schedule.EF, &schedule.LS, &schedule.LF, &schedule.slack};
+        for (int c = 0; c < 5; ++c)
+        {
+            out.text(keys[c]);
+            out.number((*columns[c])[i]);
+        }
+        out.text(",\"critical\":");
+        out.number(critical[i]);
+        out.text("}\n");
+    }
+}
+
+template <typename T>
+void writeBinary(const ProjectGraph& graph,
+                 const ProjectSchedule<T>& schedule,
+                 const std::vector<int>& criticalPath,
+                 double totalDuration,
+                 double standardDeviation,
+                 OutputBuffer& out)
+{
+    ScheduleExportHeader header;
+    std::memcpy(header.magic, ScheduleExportHeader::kMagic, sizeof(header.magic));
+    header.version = ScheduleExportHeader::kVersion;
+    header.valueBytes = sizeof(T);
+    header.taskCount = graph.size();
+    header.criticalCount = static_cast<std::int64_t>(criticalPath.size());
+    header.totalDuration = totalDuration;
+    header.standardDeviation = standardDeviation;
+    out.bytes(&header, sizeof(header));
+
+    const std::size_t count = static_cast<std::size_t>(graph.size());
+    out.bytes(graph.taskIds().data(), count * sizeof(int));
+    if constexpr (std::is_same_v<T, int>)
+    {
+        out.bytes(graph.durations().data(), count * sizeof(T));
+    }
+    else
+    {
+        out.bytes(graph.expectedDurations().data(), count * sizeof(T));
+    }
+    for (const std::vector<T>* column : {&schedule.ES, &schedule.EF, &schedule.LS, &schedule.LF, &schedule.slack})
+    {
+        out.bytes(column->data(), count * sizeof(T));
+    }
+    out.bytes(criticalPath.data(), criticalPath.size() * sizeof(int));
+}
+
+template <typename T>
+bool writeSchedule(const ProjectGraph& graph,
+                   const ProjectSchedule<T>& schedule,
+                   const std::vector<int>& criticalPath,
+                   double totalDuration,
+                   const double* standardDeviation,
+                   ExportFormat format,
+                   std::ostream& output)
+{
+    OutputBuffer out(output);
+    switch (format)
+    {
+    case ExportFormat::Csv:
+        writeCsv(graph, schedule, criticalPositions(graph, criticalPath), out);
+        break;
+    case ExportFormat::JsonLines:
+        writeJsonLines(graph, schedule, criticalPath, totalDuration, standardDeviation,
+                       criticalPositions(graph, criticalPath), out);
+        break;
+    case ExportFormat::Binary:
+        writeBinary(graph, schedule, criticalPath, totalDuration,
+                    standardDeviation != nullptr ? *standardDeviation : 0.0, out);
+        break;
+    }
+    return out.flush() && static_cast<bool>(output.flush());
+}
+
+const char* binningName(HistogramBinning binning)
+{
+    switch (binning)
+    {
+    case HistogramBinning::Fixed:
+        return "fixed";
+    case HistogramBinning::Adaptive:
+        return "adaptive";
+    case HistogramBinning::LogLinear:
+        return "log-linear";
+    }
+    return "";
+}
+}
+
+bool ScheduleExporter::write(const ProjectGraph& graph,
+                             const ProjectSchedule<int>& schedule,
+                             const CPMResult& result,
+                             ExportFormat format,
+                             std::ostream& output)
+{
+    return writeSchedule(graph, schedule, result.criticalPath, result.totalDuration, nullptr, format, output);
+}
+
+bool ScheduleExporter::write(const ProjectGraph& graph,
+                             const ProjectSchedule<double>& schedule,
+                             const PERTResult& result,
+                             ExportFormat format,
+                             std::ostream& output)
+{
+    return writeSchedule(graph, schedule, result.criticalPath, result.expectedDuration, &result.standardDeviation,
+                         format, output);
+}
+
+bool ScheduleExporter::write(const Histogram& histogram, ExportFormat format, std::ostream& output)
+{
+    OutputBuffer out(output);
+    const int binCount = histogram.binCount();
+    switch (format)
+    {
+    case ExportFormat::Csv:
+        out.reserve(kMaxRowBytes);
+        out.text("bin_start,bin_end,count\n");
+        for (int bin = 0; bin < binCount; ++bin)
+        {
+            out.reserve(kMaxRowBytes);
+            out.number(histogram.binStart(bin));
+            out.character(',');
+            out.number(histogram.binEnd(bin));
+            out.character(',');
+            out.number(histogram.counts()[bin]);
+            out.character('\n');
+        }
+        break;
+    case ExportFormat::JsonLines:
+        out.reserve(kMaxRowBytes);
+        out.text("{\"binning\":\"");
+        out.text(binningName(histogram.binning()));
+        out.text("\",\"bins\":");
+        out.number(binCount);
+        out.text(",\"samples\":");
+        out.number(histogram.count());
+        out.text("}\n");
+        for (int bin = 0; bin < binCount; ++bin)
+        {
+            out.reserve(kMaxRowBytes);
+            out.text("{\"bin_start\":");
+            out.number(histogram.binStart(bin));
+            out.text(",\"bin_end\":");
+            out.number(histogram.binEnd(bin));
+            out.text(",\"count\":");
+            out.number(histogram.counts()[bin]);
+            out.text("}\n");
+        }
+        break;
+    case ExportFormat::Binary:
+    {
+        HistogramExportHeader header;
+        std::memcpy(header.magic, HistogramExportHeader::kMagic, sizeof(header.magic));
+        header.version = HistogramExportHeader::kVersion;
+        header.binning = static_cast<std::uint32_t>(histogram.binning());
+        header.binCount = binCount;
+        header.sampleCount = histogram.count();
+        out.bytes(&header, sizeof(header));
+
+        std::vector<double> starts(binCount);
+        std::vector<double> ends(binCount);
+        for (int bin = 0; bin < binCount; ++bin)
+        {
+            starts[bin] = histogram.binStart(bin);
+            ends[bin] = histogram.binEnd(bin);
+        }
+        out.bytes(starts.data(), starts.size() * sizeof(double));
+        out.bytes(ends.data(), ends.size() * sizeof(double));
+        out.bytes(histogram.counts().data(), histogram.counts().size() * sizeof(std::int64_t));
+        break;
+    }
+    }
+    return out.flush() && static_cast<bool>(output.flush());
+}
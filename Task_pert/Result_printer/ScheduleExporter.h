@@ -0,0 +1,79 @@
+#ifndef SCHEDULE_EXPORTER_H
+#define SCHEDULE_EXPORTER_H
+
+#include <cstdint>
+#include <iosfwd>
+
+#include "CPMCalculator.h"
+#include "PERTCalculator.h"
+#include "ProjectGraph.h"
+
+enum class ExportFormat
+{
+    Csv,       // header line, then one row per task
+    JsonLines, // one project object, then one object per task
+    Binary     // ScheduleExportHeader followed by the columns
+};
+
+// Binary layout (native little-endian): this header, then the columns
+// id[int32], duration, ES, EF, LS, LF, slack [int32 for CPM, float64 for
+// PERT] of taskCount tasks and criticalPath[int32] of criticalCount task ids.
+// Every column starts on an 8-byte boundary.
+struct ScheduleExportHeader
+{
+    static constexpr char kMagic[8] = {'B', 'O', 'i', 'O', 'D', 'S', 'C', 'H'};
+    static constexpr std::uint32_t kVersion = 1;
+
+    char magic[8] = {};
+    std::uint32_t version = 0;
+    std::uint32_t valueBytes = 0; // 4 (CPM) or 8 (PERT)
+    std::int64_t taskCount = 0;
+    std::int64_t criticalCount = 0;
+    double totalDuration = 0.0;   // CPM total or PERT expected duration
+    double standardDeviation = 0.0; // PERT only
+};
+
+// Binary histogram layout: this header, then binStart, binEnd [float64] and
+// count [int64] columns of binCount bins.
+struct HistogramExportHeader
+{
+    static constexpr char kMagic[8] = {'B', 'O', 'i', 'O', 'D', 'H', 'S', 'T'};
+    static constexpr std::uint32_t kVersion = 1;
+
+    char magic[8] = {};
+    std::uint32_t version = 0;
+    std::uint32_t binning = 0;    // HistogramBinning
+    std::int64_t binCount = 0;
+    std::int64_t sampleCount = 0;
+};
+
+// Machine-readable dumps of a computed schedule. Rows are in graph order
+// (ascending task id); the critical column holds the 1-based position of the
+// task on the critical path and 0 elsewhere. Everything is formatted with
+// std::to_chars into one preallocated buffer that is written out whenever it
+// fills, so large schedules stream at the speed of the stream.
+class ScheduleExporter
+{
+public:
+    static constexpr std::size_t kBufferSize = std::size_t{8} << 20;
+
+    // False when writing to `output` failed.
+    static bool write(const ProjectGraph& graph,
+                      const ProjectSchedule<int>& schedule,
+                      const CPMResult& result,
+                      ExportFormat format,
+                      std::ostream& output);
+
+    static bool write(const ProjectGraph& graph,
+                      const ProjectSchedule<double>& schedule,
+                      const PERTResult& result,
+                      ExportFormat format,
+                      std::ostream& output);
+
+    // Completion-time histogram of a simulation, one row / object per bin
+    // (CSV and JSON Lines start with the column names / a summary object), so
+    // runs with the same histogram settings can be overlaid bin for bin.
+    static bool write(const Histogram& histogram, ExportFormat format, std::ostream& output);
+};
+
+#endif // SCHEDULE_EXPORTER_H
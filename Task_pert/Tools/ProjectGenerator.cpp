@@ -0,0 +1,523 @@
+// Writes synthetic CPM or PERT projects in the text formats of DataLoader and
+// DataLoader_pert.
+//
+// Usage: ProjectGenerator cpm|pert <output.txt|-> [options]
+//   --tasks N               number of tasks (default 1000, up to 10^8 and more)
+//   --density D             average dependencies per task (default 3, may be fractional)
+//   --topology T            layered | series-parallel | random | scale-free (default layered)
+//   --numbering sorted|shuffled
+//                           sorted numbers the tasks in dependency order like
+//                           the dataSort files, shuffled permutes them like the
+//                           data files (default sorted)
+//   --seed S                (default 1)
+//   --width W               tasks per layer of the layered topology (default sqrt(N))
+//   --max-duration D        durations are drawn from 1..D (default 100)
+//   --target-time T         PERT fourth line (default 100)
+//   --target-probability P  PERT fourth line, in percent (default 95)
+//
+// Topologies, on task positions 0..N-1 in dependency order:
+//   layered          every task of a layer gets about D successors in the next layer
+//   series-parallel  a two-terminal series-parallel graph: series steps insert a
+//                    task into a dependency, parallel steps duplicate it; about
+//                    D * N edges, D being capped at 2 since such a graph without
+//                    repeated dependencies has fewer than 2N edges
+//   random           every task gets about D successors among the later tasks
+//   scale-free       successor counts follow a Pareto law (exponent 2, mean
+//                    about D), so a few tasks fan out to very many others
+//
+// Nothing is kept per task: durations and successor lists are pure functions
+// of (seed, task) drawn from RandomStream and the shuffled numbering is a keyed
+// Feistel permutation, so memory stays constant for any N. The edges are
+// generated twice, once to count M for the first line and once to write them.
+// Dependencies are written grouped by predecessor in position order (series-
+// parallel: in generation order).
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "RandomStream.h"
+
+namespace
+{
+enum class Topology
+{
+    Layered,
+    SeriesParallel,
+    Random,
+    ScaleFree
+};
+
+// Stream ids of the independent random streams.
+constexpr std::uint64_t kDurationStream = 0;
+constexpr std::uint64_t kSeriesParallelStream = 1;
+constexpr std::uint64_t kPermutationStream = 2;
+constexpr std::uint64_t kSuccessorStreams = 3; // + task position
+constexpr double kScaleFreeExponent = 2.0;
+constexpr std::size_t kWriteBuffer = std::size_t{1} << 20;
+
+struct Settings
+{
+    bool pert = false;
+    std::string output;
+    long long tasks = 1000;
+    double density = 3.0;
+    Topology topology = Topology::Layered;
+    bool shuffled = false;
+    std::uint64_t seed = 1;
+    long long width = 0;
+    int maxDuration = 100;
+    double targetTime = 100.0;
+    double targetProbability = 95.0;
+};
+
+// Bijection of 0..size-1: a balanced Feistel network on the smallest even bit
+// width covering `size`, cycle-walked back into range.
+class Permutation
+{
+public:
+    Permutation(std::uint64_t size, std::uint64_t seed) : size_(size), keys_(seed, kPermutationStream)
+    {
+        int bits = 2;
+        while ((std::uint64_t{1} << bits) < size)
+        {
+            bits += 2;
+        }
+        halfBits_ = bits / 2;
+        halfMask_ = (std::uint64_t{1} << halfBits_) - 1;
+    }
+
+    std::uint64_t operator()(std::uint64_t value) const
+    {
+        do
+        {
+            value = encrypt(value);
+        } while (value >= size_);
+        return value;
+    }
+
+private:
+    static constexpr int kRounds = 4;
+
+    std::uint64_t encrypt(std::uint64_t value) const
+    {
+        std::uint64_t left = value >> halfBits_;
+        std::uint64_t right = value & halfMask_;
+        for (int round = 0; round < kRounds; ++round)
+        {
+            const std::uint64_t mixed = left ^ (keys_.at((right << 2) | round) & halfMask_);
+            left = right;
+            right = mixed;
+        }
+        return (left << halfBits_) | right;
+    }
+
+    std::uint64_t size_;
+    RandomStream keys_;
+    int halfBits_ = 1;
+    std::uint64_t halfMask_ = 1;
+};
+
+class Writer
+{
+public:
+    explicit Writer(std::FILE* file) : file_(file) { buffer_.reserve(kWriteBuffer + 64); }
+    ~Writer() { flush(); }
+
+    template <typename T>
+    Writer& operator<<(T value)
+    {
+        char text[32];
+        const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+        buffer_.append(text, result.ptr);
+        return spill();
+    }
+
+    Writer& operator<<(const char* text)
+    {
+        buffer_.append(text);
+        return spill();
+    }
+
+    void flush()
+    {
+        if (!buffer_.empty())
+        {
+            failed_ |= std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size();
+            buffer_.clear();
+        }
+    }
+
+    bool failed() const { return failed_; }
+
+private:
+    Writer& spill()
+    {
+        if (buffer_.size() >= kWriteBuffer)
+        {
+            flush();
+        }
+        return *this;
+    }
+
+    std::FILE* file_;
+    std::string buffer_;
+    bool failed_ = false;
+};
+
+// Whole part of `density` plus one more with the probability of its fraction.
+long long roundedDensity(double density, double unit)
+{
+    const double whole = std::floor(density);
+    return static_cast<long long>(whole) + (unit < density - whole ? 1 : 0);
+}
+
+// Successor positions of the task at `position` for the per-task topologies,
+// sorted and without repeats.
+void successorsOf(const Settings& settings, long long position, std::vector<long long>& successors)
+{
+    successors.clear();
+    const long long tasks = settings.tasks;
+    const RandomStream stream(settings.seed, kSuccessorStreams + static_cast<std::uint64_t>(position));
+    std::uint64_t counter = 0;
+
+    long long first = position + 1; // range of the candidates
+    long long last = tasks - 1;
+    long long count = 0;
+    switch (settings.topology)
+    {
+    case Topology::Layered:
+    {
+        const long long layerEnd = (position / settings.width + 1) * settings.width;
+        first = layerEnd;
+        last = std::min(tasks, layerEnd + settings.width) - 1;
+        count = roundedDensity(settings.density, stream.unitAt(counter++));
+        break;
+    }
+    case Topology::Random:
+        count = roundedDensity(settings.density, stream.unitAt(counter++));
+        break;
+    case Topology::ScaleFree:
+    {
+        // Pareto(xm, 2) has mean 2 xm; flooring loses about half a task.
+        const double scale = (settings.density + 0.5) / kScaleFreeExponent;
+        const double u = 1.0 - stream.unitAt(counter++);
+        const double draw = scale * std::pow(u, -1.0 / kScaleFreeExponent);
+        count = draw < static_cast<double>(tasks) ? static_cast<long long>(draw) : tasks;
+        break;
+    }
+    case Topology::SeriesParallel:
+        return;
+    }
+    if (first > last)
+    {
+        return;
+    }
+
+    const long long candidates = last - first + 1;
+    if (count >= candidates)
+    {
+        for (long long s = first; s <= last; ++s)
+        {
+            successors.push_back(s);
+        }
+        return;
+    }
+    for (long long k = 0; k < count; ++k)
+    {
+        successors.push_back(first + static_cast<long long>(stream.unitAt(counter++) * candidates));
+    }
+    std::sort(successors.begin(), successors.end());
+    successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+}
+
+// Two-terminal series-parallel graph over positions 0..N-1 with source 0 and
+// sink N-1; calls emit(pred, succ) for every dependency. Decisions come from
+// one stream in a fixed order, so every call emits the same edges.
+template <typename Emit>
+void seriesParallel(const Settings& settings, const Emit& emit)
+{
+    struct Part
+    {
+        long long source;
+        long long sink;
+        long long interiorBegin; // interior positions lie between source and sink
+        long long interiorEnd;
+    };
+
+    const RandomStream stream(settings.seed, kSeriesParallelStream);
+    std::uint64_t counter = 0;
+    // Every parallel step adds one edge to the N - 1 of a chain; a share of
+    // D - 1 gives roughly D * N edges for D up to 2.
+    const double parallelShare = std::clamp(settings.density - 1.0, 0.0, 0.99);
+
+    std::vector<Part> stack = {{0, settings.tasks - 1, 1, settings.tasks - 1}};
+    while (!stack.empty())
+    {
+        const Part part = stack.back();
+        stack.pop_back();
+        const long long interior = part.interiorEnd - part.interiorBegin;
+        if (interior == 0)
+        {
+            emit(part.source, part.sink);
+            continue;
+        }
+
+        if (interior >= 2 && stream.unitAt(counter++) < parallelShare)
+        {
+            // Two branches between the same terminals, each with part of the interior.
+            const long long split = part.interiorBegin + 1 + static_cast<long long>(stream.unitAt(counter++) * (interior - 1));
+            stack.push_back({part.source, part.sink, split, part.interiorEnd});
+            stack.push_back({part.source, part.sink, part.interiorBegin, split});
+        }
+        else
+        {
+            // A task in the middle of the chain.
+            const long long middle = part.interiorBegin + static_cast<long long>(stream.unitAt(counter++) * interior);
+            stack.push_back({middle, part.sink, middle + 1, part.interiorEnd});
+            stack.push_back({part.source, middle, part.interiorBegin, middle});
+        }
+    }
+}
+
+template <typename Emit>
+void forEachEdge(const Settings& settings, const Emit& emit)
+{
+    if (settings.topology == Topology::SeriesParallel)
+    {
+        if (settings.tasks >= 2)
+        {
+            seriesParallel(settings, emit);
+        }
+        return;
+    }
+
+    std::vector<long long> successors;
+    for (long long position = 0; position < settings.tasks; ++position)
+    {
+        successorsOf(settings, position, successors);
+        for (long long successor : successors)
+        {
+            emit(position, successor);
+        }
+    }
+}
+
+// Whole-argument number; false for anything else, trailing text included.
+template <typename T>
+bool parseNumber(const std::string& text, T& value)
+{
+    const char* end = text.data() + text.size();
+    const std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end && !text.empty();
+}
+
+bool parseArguments(int argc, char* argv[], Settings& settings)
+{
+    if (argc < 3)
+    {
+        return false;
+    }
+
+    const std::string format = argv[1];
+    if (format != "cpm" && format != "pert")
+    {
+        return false;
+    }
+    settings.pert = format == "pert";
+    settings.output = argv[2];
+
+    for (int i = 3; i < argc; i += 2)
+    {
+        if (i + 1 == argc)
+        {
+            return false; // an option without its value
+        }
+        const std::string option = argv[i];
+        const std::string value = argv[i + 1];
+        if (option == "--tasks")
+        {
+            if (!parseNumber(value, settings.tasks))
+            {
+                return false;
+            }
+        }
+        else if (option == "--density")
+        {
+            if (!parseNumber(value, settings.density))
+            {
+                return false;
+            }
+        }
+        else if (option == "--topology")
+        {
+            if (value == "layered")
+            {
+                settings.topology = Topology::Layered;
+            }
+            else if (value == "series-parallel")
+            {
+                settings.topology = Topology::SeriesParallel;
+            }
+            else if (value == "random")
+            {
+                settings.topology = Topology::Random;
+            }
+            else if (value == "scale-free")
+            {
+                settings.topology = Topology::ScaleFree;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (option == "--numbering")
+        {
+            if (value != "sorted" && value != "shuffled")
+            {
+                return false;
+            }
+            settings.shuffled = value == "shuffled";
+        }
+        else if (option == "--seed")
+        {
+            if (!parseNumber(value, settings.seed))
+            {
+                return false;
+            }
+        }
+        else if (option == "--width")
+        {
+            if (!parseNumber(value, settings.width))
+            {
+                return false;
+            }
+        }
+        else if (option == "--max-duration")
+        {
+            if (!parseNumber(value, settings.maxDuration))
+            {
+                return false;
+            }
+        }
+        else if (option == "--target-time")
+        {
+            if (!parseNumber(value, settings.targetTime))
+            {
+                return false;
+            }
+        }
+        else if (option == "--target-probability")
+        {
+            if (!parseNumber(value, settings.targetProbability))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (settings.width <= 0)
+    {
+        settings.width = std::max(1LL, static_cast<long long>(std::sqrt(static_cast<double>(settings.tasks))));
+    }
+    return settings.tasks >= 1 && settings.tasks <= std::numeric_limits<int>::max() && settings.density >= 0.0 &&
+           std::isfinite(settings.density) && settings.maxDuration >= 1;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    if (!parseArguments(argc, argv, settings))
+    {
+        std::cerr << "Usage: " << argv[0] << " cpm|pert <output.txt|-> [--tasks N] [--density D]\n"
+                  << "       [--topology layered|series-parallel|random|scale-free] [--numbering sorted|shuffled]\n"
+                  << "       [--seed S] [--width W] [--max-duration D] [--target-time T] [--target-probability P]\n";
+        return 2;
+    }
+
+    long long edgeCount = 0;
+    forEachEdge(settings, [&](long long, long long) { ++edgeCount; });
+    if (edgeCount > std::numeric_limits<int>::max())
+    {
+        std::cerr << "Too many dependencies (" << edgeCount << "); lower --density or --tasks\n";
+        return 1;
+    }
+
+    std::FILE* file = settings.output == "-" ? stdout : std::fopen(settings.output.c_str(), "wb");
+    if (file == nullptr)
+    {
+        std::cerr << "Error: Could not open file: " << settings.output << '\n';
+        return 1;
+    }
+
+    bool failed = false;
+    {
+        Writer out(file);
+        out << settings.tasks << " " << edgeCount << "\n";
+
+        // Durations belong to task ids, so both numberings draw the same values per id.
+        const RandomStream durations(settings.seed, kDurationStream);
+        const std::uint64_t spread = static_cast<std::uint64_t>(settings.maxDuration);
+        for (long long id = 1; id <= settings.tasks; ++id)
+        {
+            const std::uint64_t counter = static_cast<std::uint64_t>(id) * 3;
+            if (settings.pert)
+            {
+                // optimistic <= most likely <= pessimistic, all within 1..maxDuration
+                std::uint64_t times[3] = {durations.at(counter) % spread + 1, durations.at(counter + 1) % spread + 1,
+                                          durations.at(counter + 2) % spread + 1};
+                std::sort(times, times + 3);
+                out << times[0] << " " << times[1] << " " << times[2] << "   ";
+            }
+            else
+            {
+                out << durations.at(counter) % spread + 1 << " ";
+            }
+        }
+        out << "\n";
+
+        const Permutation permutation(static_cast<std::uint64_t>(settings.tasks), settings.seed);
+        auto idOf = [&](long long position)
+        {
+            return (settings.shuffled ? static_cast<long long>(permutation(static_cast<std::uint64_t>(position)))
+                                      : position) + 1;
+        };
+        forEachEdge(settings, [&](long long pred, long long succ) { out << idOf(pred) << " " << idOf(succ) << "  "; });
+        out << "\n";
+
+        if (settings.pert)
+        {
+            out << settings.targetTime << " " << settings.targetProbability << "\n";
+        }
+        out.flush();
+        failed = out.failed();
+    }
+
+    if (file != stdout)
+    {
+        failed |= std::fclose(file) != 0;
+    }
+    else
+    {
+        failed |= std::fflush(stdout) != 0;
+    }
+    if (failed)
+    {
+        std::cerr << "Error: Could not write: " << settings.output << '\n';
+        return 1;
+    }
+    return 0;
+}
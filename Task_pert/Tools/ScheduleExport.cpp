@@ -0,0 +1,134 @@
+// Analyses a CPM or PERT text file and exports the schedule.
+//
+// Usage: ScheduleExport cpm|pert <input.txt> csv|jsonl|binary <output|->
+//                       [<histogram output> <simulations>]
+//
+// The input goes through the regular text loader ("-" reads stdin); the
+// schedule comes from CPMCalculator::analyze or PERTCalculator::analyze and is
+// written by ScheduleExporter ("-" writes stdout). For PERT input, the two
+// optional arguments also run a seeded Monte Carlo simulation and write its
+// completion-time histogram in the same format.
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "CPMCalculator.h"
+#include "DataLoader.h"
+#include "DataLoader_pert.h"
+#include "PERTCalculator.h"
+#include "ProjectGraph.h"
+#include "ScheduleExporter.h"
+
+namespace
+{
+// Whole-argument decimal number; false for anything else, trailing text included.
+bool parseNumber(const char* text, int& value)
+{
+    const char* end = text + std::strlen(text);
+    const std::from_chars_result result = std::from_chars(text, end, value);
+    return result.ec == std::errc() && result.ptr == end && text != end;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int simulations = 0;
+    if ((argc != 5 && !(argc == 7 && std::string(argv[1]) == "pert")) ||
+        (argc == 7 && !(parseNumber(argv[6], simulations) && simulations > 0)))
+    {
+        std::cerr << "Usage: " << argv[0] << " cpm|pert <input.txt> csv|jsonl|binary <output|->"
+                  << " [<histogram output> <simulations>]\n";
+        return 2;
+    }
+
+    const std::string kind = argv[1];
+    const std::string input = argv[2];
+    const std::string formatName = argv[3];
+    const std::string outputName = argv[4];
+
+    ExportFormat format = ExportFormat::Csv;
+    if (formatName == "jsonl")
+    {
+        format = ExportFormat::JsonLines;
+    }
+    else if (formatName == "binary")
+    {
+        format = ExportFormat::Binary;
+    }
+    else if (formatName != "csv")
+    {
+        std::cerr << "Unknown export format: " << formatName << " (expected csv, jsonl or binary)\n";
+        return 2;
+    }
+    if (kind != "cpm" && kind != "pert")
+    {
+        std::cerr << "Unknown format: " << kind << " (expected cpm or pert)\n";
+        return 2;
+    }
+
+    std::ofstream file;
+    if (outputName != "-")
+    {
+        file.open(outputName, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Error: Could not open file: " << outputName << '\n';
+            return 1;
+        }
+    }
+    std::ostream& output = outputName == "-" ? std::cout : file;
+
+    bool written = false;
+    if (kind == "cpm")
+    {
+        const ProjectData data = DataLoader::read_data(input);
+        if (!data.success)
+        {
+            std::cerr << "Error while reading project data: " << input << '\n';
+            return 1;
+        }
+        const ProjectGraph graph = ProjectGraph::compile(data.tasks);
+        ProjectSchedule<int> schedule;
+        const CPMResult result = CPMCalculator::analyze(graph, schedule);
+        written = ScheduleExporter::write(graph, schedule, result, format, output);
+    }
+    else
+    {
+        const ProjectDataPert data = DataLoader_pert::read_data(input);
+        if (!data.success)
+        {
+            std::cerr << "Error while reading pert data: " << input << '\n';
+            return 1;
+        }
+        const ProjectGraph graph = ProjectGraph::compile(data.tasks);
+        ProjectSchedule<double> schedule;
+        const PERTResult result = PERTCalculator::analyze(graph, schedule);
+        written = ScheduleExporter::write(graph, schedule, result, format, output);
+
+        if (written && argc == 7)
+        {
+            SimulationOptions options;
+            options.numSimulations = simulations;
+            options.keepSamples = false;
+            options.hasSeed = true;
+            const PERTSimulation simulation = PERTCalculator::analyzeSimulation(graph, options);
+
+            std::ofstream histogramFile(argv[5], std::ios::binary);
+            if (!histogramFile || !ScheduleExporter::write(simulation.histogram, format, histogramFile))
+            {
+                std::cerr << "Error: Could not write: " << argv[5] << '\n';
+                return 1;
+            }
+        }
+    }
+
+    if (!written)
+    {
+        std::cerr << "Error: Could not write: " << outputName << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+// Converts a CPM or PERT text file into a binary project snapshot.
+//
+// Usage: SnapshotConverter cpm|pert <input.txt> <output.snapshot>
+//
+// The input goes through the regular text loader ("-" reads stdin); the
+// snapshot can then be opened with SnapshotLoader::read_data.
+
+#include <iostream>
+#include <string>
+
+#include "DataLoader.h"
+#include "DataLoader_pert.h"
+#include "ProjectSnapshot.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc != 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " cpm|pert <input.txt> <output.snapshot>\n";
+        return 2;
+    }
+
+    const std::string format = argv[1];
+    const std::string input = argv[2];
+    const std::string output = argv[3];
+
+    bool written = false;
+    if (format == "cpm")
+    {
+        const ProjectData data = DataLoader::read_data(input);
+        if (!data.success)
+        {
+            std::cerr << "Error while reading project data: " << input << '\n';
+            return 1;
+        }
+        written = SnapshotLoader::write_data(output, data);
+    }
+    else if (format == "pert")
+    {
+        const ProjectDataPert data = DataLoader_pert::read_data(input);
+        if (!data.success)
+        {
+            std::cerr << "Error while reading pert data: " << input << '\n';
+            return 1;
+        }
+        written = SnapshotLoader::write_data(output, data);
+    }
+    else
+    {
+        std::cerr << "Unknown format: " << format << " (expected cpm or pert)\n";
+        return 2;
+    }
+
+    return written ? 0 : 1;
+}
@@ -1,25 +1,86 @@
 ﻿#include <iostream>
 #include <string>
+#include <charconv>
 #include <chrono>
+#include <cstring>
 #include <iomanip>
+#include <vector>
 
+#include "BatchRunner.h"
 #include "CPMCalculator.h"
 #include "DataLoader.h"
 #include "DataLoader_pert.h"
 #include "PERTCalculator.h"
+#include "PathEnumerator.h"
+#include "ProjectGraph.h"
 #include "ResultPrinter.h"
 
 namespace
 {
 constexpr const char* kDefaultCpmFile = "problem_data/data00.txt";
 constexpr const char* kDefaultPertFile = "problem_data/pert_data_3.txt";
+constexpr int kListedPaths = 5;
+
+// Whole-argument decimal number; false for anything else, trailing text included.
+template <typename T>
+bool parseNumber(const char* text, T& value)
+{
+    const char* end = text + std::strlen(text);
+    const std::from_chars_result result = std::from_chars(text, end, value);
+    return result.ec == std::errc() && result.ptr == end && text != end;
+}
+
+// Thread counts: 0 (one per hardware core) or more.
+bool parseThreadCount(const char* text, int& threadCount)
+{
+    return parseNumber(text, threadCount) && threadCount >= 0;
+}
+
+// --batch <directory|list file> [threads]: analyses and checks every file of a corpus.
+int runBatch(int argc, char* argv[])
+{
+    BatchOptions options;
+    if (argc < 3 || (argc > 3 && !parseThreadCount(argv[3], options.threadCount)))
+    {
+        std::cerr << "Usage: " << argv[0] << " --batch <directory|list file> [threads]\n";
+        return 2;
+    }
+
+    const std::vector<std::string> files = BatchRunner::collectFiles(argv[2]);
+    if (files.empty())
+    {
+        std::cerr << "Error: No project files found in: " << argv[2] << '\n';
+        return 1;
+    }
+
+    const BatchSummary summary = BatchRunner::run(files, options);
+    ResultPrinter::printBatch(summary, std::cout);
+    return summary.count(BatchStatus::Failed) + summary.count(BatchStatus::Error) == 0 ? 0 : 1;
+}
 }
 
 int main(int argc, char* argv[])
 {
+    if (argc > 1 && std::string(argv[1]) == "--batch")
+    {
+        return runBatch(argc, argv);
+    }
+
     const std::string cpmFile = argc > 1 ? argv[1] : kDefaultCpmFile;
     const std::string pertFile = argc > 2 ? argv[2] : kDefaultPertFile;
 
+    SimulationOptions simulationOptions;
+    simulationOptions.hasSeed = argc > 3;
+    double overrunDeadline = 0.0;
+    if ((argc > 3 && !parseNumber(argv[3], simulationOptions.seed)) ||
+        (argc > 4 && !parseThreadCount(argv[4], simulationOptions.threadCount)) ||
+        (argc > 5 && !parseNumber(argv[5], overrunDeadline)))
+    {
+        std::cerr << "Usage: " << argv[0] << " [cpm file] [pert file] [seed] [threads] [overrun deadline]\n"
+                  << "       " << argv[0] << " --batch <directory|list file> [threads]\n";
+        return 2;
+    }
+
     ProjectData projectData = DataLoader::read_data(cpmFile);
     if (!projectData.success)
     {
@@ -34,31 +95,65 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    const ProjectGraph cpmGraph = ProjectGraph::compile(projectData.tasks);
+    const ProjectGraph pertGraph = ProjectGraph::compile(pertData.tasks);
+
     // CPM Analysis with timing
+    ProjectSchedule<int> cpmSchedule;
     auto startCPM = std::chrono::high_resolution_clock::now();
-    CPMResult cpmResult = CPMCalculator::analyze(projectData.tasks);
+    CPMResult cpmResult = CPMCalculator::analyze(cpmGraph, cpmSchedule);
     auto endCPM = std::chrono::high_resolution_clock::now();
     auto durationCPM = std::chrono::duration_cast<std::chrono::microseconds>(endCPM - startCPM);
 
     // CPM Bellman-Ford with timing
     auto startCPMBF = std::chrono::high_resolution_clock::now();
-    CPMResult cpmResultBF = CPMCalculator::analyzeBellmanFord(projectData.tasks);
+    CPMResult cpmResultBF = CPMCalculator::analyzeBellmanFord(cpmGraph, cpmSchedule);
     auto endCPMBF = std::chrono::high_resolution_clock::now();
     auto durationCPMBF = std::chrono::duration_cast<std::chrono::microseconds>(endCPMBF - startCPMBF);
 
     // PERT Analysis with timing
+    ProjectSchedule<double> pertSchedule;
     auto startPERT = std::chrono::high_resolution_clock::now();
-    PERTResult pertResult = PERTCalculator::analyze(pertData.tasks);
+    PERTResult pertResult = PERTCalculator::analyze(pertGraph, pertSchedule);
     auto endPERT = std::chrono::high_resolution_clock::now();
     auto durationPERT = std::chrono::duration_cast<std::chrono::microseconds>(endPERT - startPERT);
 
-    // PERT Simulation with timing
-    constexpr int kNumSimulations = 1000000;
+    // Clark approximation of the completion distribution with timing
+    auto startClark = std::chrono::high_resolution_clock::now();
+    ClarkEstimate clarkResult = PERTCalculator::analyzeClark(pertGraph);
+    auto endClark = std::chrono::high_resolution_clock::now();
+    auto durationClark = std::chrono::duration_cast<std::chrono::microseconds>(endClark - startClark);
+
+    // PERT Simulation with timing: sample until the on-time probability is known
+    // to +/-0.001 (95% confidence), within the sample and time limits.
+    constexpr int kMaxSimulations = 20000000;
+    simulationOptions.numSimulations = kMaxSimulations;
+    simulationOptions.stopping.target = StoppingTarget::Probability;
+    simulationOptions.stopping.time = pertData.target_time;
+    simulationOptions.stopping.halfWidth = 0.001;
+    simulationOptions.stopping.timeBudgetSeconds = 10.0;
+    simulationOptions.trackCriticality = true;
+
     auto startMC = std::chrono::high_resolution_clock::now();
-    PERTSimulation simulationResult = PERTCalculator::analyzeSimulation(pertData.tasks, kNumSimulations);
+    PERTSimulation simulationResult = PERTCalculator::analyzeSimulation(pertGraph, simulationOptions);
     auto endMC = std::chrono::high_resolution_clock::now();
     auto durationMC = std::chrono::duration_cast<std::chrono::microseconds>(endMC - startMC);
 
+    // Importance-sampled probability of overrunning the file's target time (or the given deadline)
+    ImportanceSamplingOptions overrunOptions;
+    overrunOptions.seed = simulationOptions.seed;
+    overrunOptions.hasSeed = simulationOptions.hasSeed;
+    overrunOptions.threadCount = simulationOptions.threadCount;
+    if (argc <= 5)
+    {
+        overrunDeadline = pertData.target_time;
+    }
+
+    auto startIS = std::chrono::high_resolution_clock::now();
+    OverrunEstimate overrunResult = PERTCalculator::analyzeOverrun(pertGraph, overrunDeadline, overrunOptions);
+    auto endIS = std::chrono::high_resolution_clock::now();
+    auto durationIS = std::chrono::duration_cast<std::chrono::microseconds>(endIS - startIS);
+
     std::cout << "File paths:\n";
     std::cout << "  CPM data file: " << cpmFile << '\n';
 
@@ -68,6 +163,14 @@ int main(int argc, char* argv[])
     std::cout << "  PERT data file: " << pertFile << '\n';
     ResultPrinter::printPERT(pertData, pertResult, std::cout);
     ResultPrinter::printSimulation(simulationResult, pertData.target_time, pertData.target_probability, std::cout);
+    ResultPrinter::printProbabilityTable(pertResult, &clarkResult, &simulationResult, std::cout);
+
+    PathQuery pathQuery;
+    pathQuery.maxPaths = kListedPaths;
+    ResultPrinter::printPaths(pertData, PathEnumerator::longestPaths(pertGraph, pertGraph.expectedDurations(), pathQuery),
+                              pertData.target_time, std::cout);
+    ResultPrinter::printCriticality(pertData, simulationResult, std::cout);
+    ResultPrinter::printOverrun(overrunResult, std::cout);
 
     // Display execution times
     std::cout << "\n========================================\n";
@@ -86,8 +189,14 @@ int main(int argc, char* argv[])
     std::cout << "PERT Analysis:            " << std::setw(10) << durationPERT.count() / 1000.0 << " ms";
     std::cout << " (" << durationPERT.count() << " µs)\n";
 
+    std::cout << "PERT Clark:               " << std::setw(10) << durationClark.count() / 1000.0 << " ms";
+    std::cout << " (" << durationClark.count() << " µs)\n";
+
     std::cout << "PERT Simulation:   " << std::setw(10) << durationMC.count() / 1000.0 << " ms";
     std::cout << " (" << durationMC.count() << " µs)\n";
+
+    std::cout << "PERT Overrun (IS): " << std::setw(10) << durationIS.count() / 1000.0 << " ms";
+    std::cout << " (" << durationIS.count() << " µs)\n";
     std::cout << "========================================\n";
 
     return 0;